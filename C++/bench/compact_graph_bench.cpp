@@ -0,0 +1,78 @@
+#include <bits/stdc++.h>
+#include "compact_graph.h"
+
+using namespace std;
+
+// Road-network-like input: a square grid with random positive weights
+// and a sprinkling of longer shortcut edges.
+Graph getGridGraph(size_t side, unsigned seed) {
+    Graph g(false, true);
+    mt19937 rng(seed);
+    uniform_real_distribution<float> weightDist(1, 10);
+
+    for (size_t r = 0; r < side; r++) {
+        for (size_t c = 0; c < side; c++) {
+            string v = to_string(r * side + c);
+            if (c + 1 < side) g.addEdge(v, to_string(r * side + c + 1), weightDist(rng));
+            if (r + 1 < side) g.addEdge(v, to_string((r + 1) * side + c), weightDist(rng));
+        }
+    }
+
+    for (size_t i = 0; i < side * side / 100; i++) {
+        g.addEdge(to_string(rng() % (side * side)), to_string(rng() % (side * side)), 50 + weightDist(rng));
+    }
+
+    return g;
+}
+
+template <typename F>
+double timeMs(F f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(end - start).count();
+}
+
+void benchShortestPaths(Graph & g, CompactGraph & cg) {
+    printf("shortest paths: %zu vertices, %zu edges\n", cg.numVertices(), cg.numEdges());
+    printf("  Graph::dijkstra             %8.1f ms\n", timeMs([&] { g.dijkstra("0"); }));
+    printf("  CompactGraph::dijkstra      %8.1f ms\n", timeMs([&] { cg.dijkstra("0"); }));
+
+    size_t maxThreads = max(1u, thread::hardware_concurrency());
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        printf("  deltaStepping(%2zu threads)  %8.1f ms\n", threads, timeMs([&] { cg.deltaStepping("0", 10, threads); }));
+    }
+}
+
+void benchBellmanFord(Graph & g, CompactGraph & cg) {
+    printf("bellman-ford: %zu vertices, %zu edges\n", cg.numVertices(), cg.numEdges());
+    printf("  Graph::bellmanFord          %8.1f ms\n", timeMs([&] { g.bellmanFord("0"); }));
+
+    size_t maxThreads = max(1u, thread::hardware_concurrency());
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        printf("  bellmanFord(%2zu threads)    %8.1f ms\n", threads, timeMs([&] { cg.bellmanFord("0", threads); }));
+    }
+}
+
+void benchPersistence(Graph & g, CompactGraph & cg) {
+    string path = "out/compact_graph_bench.bin";
+
+    printf("persistence: %zu vertices, %zu edges\n", cg.numVertices(), cg.numEdges());
+    printf("  CompactGraph(Graph)         %8.1f ms\n", timeMs([&] { CompactGraph copy(g); }));
+    printf("  save                        %8.1f ms\n", timeMs([&] { cg.save(path); }));
+    printf("  load + dijkstra             %8.1f ms\n", timeMs([&] { CompactGraph::load(path).dijkstra("0"); }));
+    printf("  load                        %8.3f ms\n", timeMs([&] { CompactGraph::load(path); }));
+
+    remove(path.c_str());
+}
+
+int main() {
+    Graph g = getGridGraph(400, 42);
+    CompactGraph cg(g);
+
+    benchShortestPaths(g, cg);
+    benchBellmanFord(g, cg);
+    benchPersistence(g, cg);
+
+    return 0;
+}
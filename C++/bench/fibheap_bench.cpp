@@ -0,0 +1,48 @@
+#include <bits/stdc++.h>
+#include "fibheap.h"
+
+using namespace std;
+
+// Pushes n random keys, then drains the heap. The first pop after the
+// pushes consolidates a root list of length n.
+template <typename Heap, typename T>
+void pushThenDrain(const vector<T> & elems, unsigned seed) {
+    mt19937 rng(seed);
+    Heap heap;
+
+    auto start = chrono::steady_clock::now();
+    for (const T & elem : elems) {
+        heap.push(elem, rng() % 1000000);
+    }
+    auto pushed = chrono::steady_clock::now();
+
+    heap.pop();
+    auto firstPop = chrono::steady_clock::now();
+
+    while (!heap.empty()) {
+        heap.pop();
+    }
+    auto end = chrono::steady_clock::now();
+
+    printf("%s n = %8zu: push %8.1f ms, first pop %8.1f ms, drain %8.1f ms\n",
+        is_same<T, string>::value ? "string" : "id    ", elems.size(),
+        chrono::duration<double, milli>(pushed - start).count(),
+        chrono::duration<double, milli>(firstPop - pushed).count(),
+        chrono::duration<double, milli>(end - firstPop).count());
+}
+
+int main() {
+    for (size_t n : {10000, 100000, 1000000}) {
+        vector<string> elems;
+        vector<uint32_t> ids;
+        for (size_t i = 0; i < n; i++) {
+            elems.push_back(to_string(i));
+            ids.push_back(i);
+        }
+
+        pushThenDrain<FibonacciHeap>(elems, 11);
+        pushThenDrain<BasicFibonacciHeap<uint32_t, float>>(ids, 11);
+    }
+
+    return 0;
+}
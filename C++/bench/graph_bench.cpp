@@ -0,0 +1,312 @@
+#include <bits/stdc++.h>
+#include "dary_heap.h"
+#include "fibheap.h"
+#include "graph.h"
+#include "pairing_heap.h"
+#include "radix_heap.h"
+
+using namespace std;
+
+static size_t allocations = 0;
+
+void * operator new(size_t size) {
+    allocations++;
+    void * p = malloc(size);
+    if (p == NULL) throw bad_alloc();
+    return p;
+}
+
+void operator delete(void * p) noexcept {
+    free(p);
+}
+
+void operator delete(void * p, size_t) noexcept {
+    free(p);
+}
+
+Graph getRandomGraph(size_t n, size_t m, unsigned seed, bool directed = true) {
+    Graph g(directed, true);
+    mt19937 rng(seed);
+    uniform_int_distribution<size_t> vertexDist(0, n - 1);
+    uniform_real_distribution<float> weightDist(1, 100);
+
+    for (size_t i = 0; i < n; i++) {
+        g.addVertex("v" + to_string(i));
+    }
+
+    for (size_t i = 0; i < m; i++) {
+        string a = "v" + to_string(vertexDist(rng));
+        string b = "v" + to_string(vertexDist(rng));
+        g.addEdge(a, b, weightDist(rng));
+    }
+
+    return g;
+}
+
+void benchBuild(size_t n, size_t m, unsigned seed) {
+    mt19937 rng(seed);
+    uniform_int_distribution<size_t> vertexDist(0, n - 1);
+    uniform_real_distribution<float> weightDist(1, 100);
+
+    vector<tuple<string, string, float>> edges;
+    for (size_t i = 0; i < m; i++) {
+        edges.push_back(make_tuple("v" + to_string(vertexDist(rng)), "v" + to_string(vertexDist(rng)), weightDist(rng)));
+    }
+
+    auto start = chrono::steady_clock::now();
+    Graph incremental(true, true);
+    for (const tuple<string, string, float> & e : edges) {
+        incremental.addEdge(get<0>(e), get<1>(e), get<2>(e));
+    }
+    auto end = chrono::steady_clock::now();
+    double addEdgeMs = chrono::duration<double, milli>(end - start).count();
+
+    start = chrono::steady_clock::now();
+    Graph bulk = Graph::fromEdges(true, true, edges);
+    end = chrono::steady_clock::now();
+    double fromEdgesMs = chrono::duration<double, milli>(end - start).count();
+
+    printf("build: %zu edges, addEdge %.1f ms, fromEdges %.1f ms\n", m, addEdgeMs, fromEdgesMs);
+}
+
+void benchEdgeValueLookup(Graph & g) {
+    vector<pair<string, string>> edges;
+    for (auto kvPair : g.getEdges()) {
+        for (string v : kvPair.second) {
+            edges.push_back({kvPair.first, v});
+        }
+    }
+
+    size_t before = allocations;
+    auto start = chrono::steady_clock::now();
+
+    float total = 0;
+    for (const pair<string, string> & e : edges) {
+        total += g.getEdgeValue(e.first, e.second);
+    }
+
+    auto end = chrono::steady_clock::now();
+    double ns = chrono::duration<double, nano>(end - start).count();
+
+    printf("getEdgeValue: %zu lookups, %.2f allocs/lookup, %.1f ns/lookup (checksum %.0f)\n",
+        edges.size(), (double) (allocations - before) / edges.size(), ns / edges.size(), total);
+}
+
+void benchEdgeValueLookupById(Graph & g) {
+    vector<pair<uint32_t, uint32_t>> edges;
+    for (auto kvPair : g.getEdges()) {
+        for (string v : kvPair.second) {
+            edges.push_back({g.getId(kvPair.first), g.getId(v)});
+        }
+    }
+
+    size_t before = allocations;
+    auto start = chrono::steady_clock::now();
+
+    float total = 0;
+    for (const pair<uint32_t, uint32_t> & e : edges) {
+        total += g.getEdgeValue(e.first, e.second);
+    }
+
+    auto end = chrono::steady_clock::now();
+    double ns = chrono::duration<double, nano>(end - start).count();
+
+    printf("getEdgeValue(id): %zu lookups, %.2f allocs/lookup, %.1f ns/lookup (checksum %.0f)\n",
+        edges.size(), (double) (allocations - before) / edges.size(), ns / edges.size(), total);
+}
+
+void benchDijkstra(Graph & g) {
+    size_t relaxations = 0;
+    for (auto kvPair : g.getEdges()) {
+        relaxations += kvPair.second.size();
+    }
+
+    size_t before = allocations;
+    auto start = chrono::steady_clock::now();
+
+    g.dijkstra("v0");
+
+    auto end = chrono::steady_clock::now();
+    double ms = chrono::duration<double, milli>(end - start).count();
+
+    printf("dijkstra: %zu edges, %.2f allocs/edge, %.1f ms\n",
+        relaxations, (double) (allocations - before) / relaxations, ms);
+}
+
+void benchBellmanFord(Graph & g) {
+    auto start = chrono::steady_clock::now();
+    g.bellmanFord("v0");
+    auto end = chrono::steady_clock::now();
+    double bellmanFordMs = chrono::duration<double, milli>(end - start).count();
+
+    start = chrono::steady_clock::now();
+    g.spfa("v0");
+    end = chrono::steady_clock::now();
+    double spfaMs = chrono::duration<double, milli>(end - start).count();
+
+    printf("bellmanFord: %.1f ms, spfa: %.1f ms\n", bellmanFordMs, spfaMs);
+}
+
+void benchMst(Graph & g) {
+    const char * names[] = {"prim", "kruskal", "boruvka"};
+
+    for (Graph::MstAlgorithm algorithm : {Graph::PRIM, Graph::KRUSKAL, Graph::BORUVKA}) {
+        auto start = chrono::steady_clock::now();
+        g.mst(algorithm);
+        auto end = chrono::steady_clock::now();
+        double ms = chrono::duration<double, milli>(end - start).count();
+
+        printf("mst(%s): %.1f ms\n", names[algorithm], ms);
+    }
+}
+
+// Road networks are close to planar with small degrees, so a grid with
+// random positive weights stands in for one.
+Graph getGridGraph(size_t side, unsigned seed) {
+    mt19937 rng(seed);
+    vector<tuple<string, string, float>> edges;
+
+    for (size_t r = 0; r < side; r++) {
+        for (size_t c = 0; c < side; c++) {
+            string u = "v" + to_string(r * side + c);
+            if (c + 1 < side) edges.emplace_back(u, "v" + to_string(r * side + c + 1), 1 + rng() % 100);
+            if (r + 1 < side) edges.emplace_back(u, "v" + to_string((r + 1) * side + c), 1 + rng() % 100);
+        }
+    }
+
+    return Graph::fromEdges(false, true, edges);
+}
+
+const int QUEUE_RUNS = 3;
+
+template <typename Queue>
+double timeDijkstra(Graph & g) {
+    double best = numeric_limits<double>::max();
+    for (int run = 0; run < QUEUE_RUNS; run++) {
+        auto start = chrono::steady_clock::now();
+        g.dijkstra<Queue>("v0");
+        auto end = chrono::steady_clock::now();
+        best = min(best, chrono::duration<double, milli>(end - start).count());
+    }
+
+    return best;
+}
+
+template <typename Queue>
+double timePrim(Graph & g) {
+    double best = numeric_limits<double>::max();
+    for (int run = 0; run < QUEUE_RUNS; run++) {
+        auto start = chrono::steady_clock::now();
+        g.mst<Queue>(Graph::PRIM);
+        auto end = chrono::steady_clock::now();
+        best = min(best, chrono::duration<double, milli>(end - start).count());
+    }
+
+    return best;
+}
+
+// Dijkstra's search loop alone, on the heap directly: no result maps are
+// built, so the time is the queue plus the adjacency scans. Vertex ids
+// must be dense.
+template <typename Heap>
+double timeSearch(Graph & g) {
+    size_t n = g.getVertices().size();
+    double best = numeric_limits<double>::max();
+
+    for (int run = 0; run < QUEUE_RUNS; run++) {
+        auto start = chrono::steady_clock::now();
+        vector<float> dist(n, numeric_limits<float>::max());
+        vector<bool> settled(n, false);
+        Heap heap;
+        heap.reserve(n);
+
+        uint32_t source = g.getId("v0");
+        dist[source] = 0;
+        heap.push(source, 0);
+        while (!heap.empty()) {
+            uint32_t u = heap.top();
+            heap.pop();
+            settled[u] = true;
+
+            for (const Graph::Neighbor & entry : g.neighbors(u)) {
+                float alt = dist[u] + entry.edgeValue;
+                if (settled[entry.id] || alt >= dist[entry.id]) continue;
+
+                if (heap.contains(entry.id)) heap.decreaseKey(entry.id, alt);
+                else heap.push(entry.id, alt);
+                dist[entry.id] = alt;
+            }
+        }
+
+        auto end = chrono::steady_clock::now();
+        best = min(best, chrono::duration<double, milli>(end - start).count());
+    }
+
+    return best;
+}
+
+void benchQueues(Graph & g, const char * name) {
+    printf("%s search: fibonacci %.1f ms, pairing %.1f ms, 4-ary %.1f ms, radix %.1f ms\n", name,
+        timeSearch<BasicFibonacciHeap<uint32_t, float, less<float>, heap_dense_index>>(g),
+        timeSearch<BasicPairingHeap<uint32_t, float, less<float>, heap_dense_index>>(g),
+        timeSearch<BasicDaryHeap<uint32_t, float, less<float>, heap_dense_index>>(g),
+        timeSearch<BasicRadixHeap<uint32_t, float, heap_dense_index>>(g));
+
+    printf("%s dijkstra: fibonacci %.1f ms, pairing %.1f ms, 4-ary %.1f ms, radix %.1f ms\n", name,
+        timeDijkstra<Graph::FibonacciQueue>(g), timeDijkstra<Graph::PairingQueue>(g),
+        timeDijkstra<Graph::DaryQueue>(g), timeDijkstra<Graph::RadixQueue>(g));
+
+    if (g.isDirected()) return;
+    printf("%s prim: fibonacci %.1f ms, pairing %.1f ms, 4-ary %.1f ms\n", name,
+        timePrim<Graph::FibonacciQueue>(g), timePrim<Graph::PairingQueue>(g),
+        timePrim<Graph::DaryQueue>(g));
+}
+
+void benchFloydWarshall(Graph & g, size_t threads) {
+    size_t n = g.getVertices().size();
+    auto start = chrono::steady_clock::now();
+
+    g.floydWarshall(threads);
+
+    auto end = chrono::steady_clock::now();
+    double ms = chrono::duration<double, milli>(end - start).count();
+
+    printf("floydWarshall: %zu vertices, %zu threads, %.1f ms\n", n, threads, ms);
+}
+
+void benchJohnson(Graph & g, size_t threads) {
+    size_t n = g.getVertices().size();
+    auto start = chrono::steady_clock::now();
+
+    g.johnson(threads);
+
+    auto end = chrono::steady_clock::now();
+    double ms = chrono::duration<double, milli>(end - start).count();
+
+    printf("johnson: %zu vertices, %zu threads, %.1f ms\n", n, threads, ms);
+}
+
+int main() {
+    Graph g = getRandomGraph(20000, 200000, 42);
+
+    benchBuild(200000, 2000000, 3);
+    benchEdgeValueLookup(g);
+    benchEdgeValueLookupById(g);
+    benchDijkstra(g);
+    benchBellmanFord(g);
+
+    Graph undirected = getRandomGraph(20000, 200000, 42, false);
+    benchMst(undirected);
+
+    benchQueues(g, "random");
+    Graph grid = getGridGraph(400, 9);
+    benchQueues(grid, "grid");
+
+    Graph dense = getRandomGraph(1000, 20000, 7);
+    benchFloydWarshall(dense, 1);
+    benchFloydWarshall(dense, 4);
+    benchJohnson(dense, 1);
+    benchJohnson(dense, 4);
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <bits/stdc++.h>
+#include "graph_loader.h"
+
+using namespace std;
+
+string writeEdgeList(size_t n, size_t m, unsigned seed) {
+    string path = "out/graph_loader_bench.txt";
+    mt19937 rng(seed);
+    ofstream out(path);
+
+    out << "# random edge list\n";
+    for (size_t i = 0; i < m; i++) {
+        out << rng() % n << '\t' << rng() % n << '\t' << rng() % 1000 << '\n';
+    }
+
+    return path;
+}
+
+double loadWithStreams(const string & path, Graph & g) {
+    auto start = chrono::steady_clock::now();
+    ifstream in(path);
+    string line;
+
+    while (getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        istringstream tokens(line);
+        string u, v;
+        float w;
+        tokens >> u >> v >> w;
+        g.addEdge(u, v, w);
+    }
+
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double>(end - start).count();
+}
+
+int main() {
+    size_t m = 2000000;
+    string path = writeEdgeList(200000, m, 5);
+
+    Graph naive(true, true);
+    double naiveSeconds = loadWithStreams(path, naive);
+    printf("getline + addEdge:       %8.0f edges/s\n", m / naiveSeconds);
+
+    size_t maxThreads = max(1u, thread::hardware_concurrency());
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        GraphLoader loader(GraphLoader::EDGE_LIST, threads);
+        loader.load(path, true, true);
+        printf("GraphLoader(%2zu threads): %8.0f edges/s, %.1f MB/s\n", threads,
+            loader.edgesPerSecond(), loader.bytesRead() / loader.seconds() / 1e6);
+    }
+
+    remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,54 @@
+#ifndef COMPACT_GRAPH_H
+#define COMPACT_GRAPH_H
+
+#include <unordered_set>
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "graph.h"
+
+// Read-only snapshot of a Graph: vertices are interned to dense ids
+// (assigned in sorted order) and edges are stored in compressed sparse
+// row form with a parallel weight array. Directed graphs also keep the
+// transposed rows so incoming edges can be scanned. Everything lives in
+// one flat image, which save() writes out as is and load() maps back in
+// without parsing.
+class CompactGraph {
+public:
+    CompactGraph(const Graph & g);
+    CompactGraph(const CompactGraph &);
+    CompactGraph& operator=(const CompactGraph &);
+    // Queries on a loaded graph read straight from the file mapping;
+    // copies take their own in-memory image. Throws std::runtime_error
+    // if the file cannot be mapped, its header does not fit the file, or
+    // its offsets or endpoints point outside their sections.
+    static CompactGraph load(std::string path);
+    // Throws std::runtime_error if the file cannot be written.
+    void save(std::string path);
+    bool empty();
+    size_t numVertices();
+    size_t numEdges();
+    bool hasVertex(std::string v);
+    uint32_t getId(std::string v);
+    std::string getVertex(uint32_t id);
+    std::vector<std::string> dfs(std::string v);
+    std::vector<std::string> bfs(std::string v);
+    std::pair<std::vector<std::string>, std::vector<int>> parallelBfs(std::string v, size_t threads = 0);
+    std::pair<std::unordered_map<std::string, float>, std::unordered_map<std::string, std::string>> dijkstra(std::string v);
+    std::pair<std::unordered_map<std::string, float>, std::unordered_map<std::string, std::string>> deltaStepping(std::string v, float delta, size_t threads = 0);
+    std::pair<std::unordered_map<std::string, float>, std::unordered_map<std::string, std::string>> bellmanFord(std::string v, size_t threads = 1);
+    std::vector<std::pair<std::string, std::string>> mst();
+    std::vector<std::string> topologicalSort();
+    std::vector<std::unordered_set<std::string>> stronglyConnectedComponents();
+    ~CompactGraph();
+
+private:
+    struct ClassVars;
+    ClassVars * ptr;
+
+    CompactGraph(ClassVars * vars);
+};
+
+#endif
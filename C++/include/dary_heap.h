@@ -0,0 +1,259 @@
+#ifndef DARY_HEAP_H
+#define DARY_HEAP_H
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+#include <assert.h>
+
+#include "heap_common.h"
+
+// Implicit d-ary heap with the same interface as BasicFibonacciHeap. Keys
+// and elements sit in one array, and a position index (one slot per
+// element) lets decreaseKey() and erase() find an element without a scan.
+// A wider node makes the tree shallower, trading more comparisons per
+// level in pop() for fewer levels and a cache-friendlier layout.
+template <
+    typename T,
+    typename Key = float,
+    typename Compare = std::less<Key>,
+    typename Hash = std::hash<T>,
+    size_t Arity = 4
+>
+class BasicDaryHeap {
+public:
+    // Elements move around the array, so a handle names the element and
+    // operations on it still go through the position index.
+    struct handle {
+        T elem;
+    };
+
+    BasicDaryHeap(Compare compare = Compare());
+    BasicDaryHeap(const BasicDaryHeap &);
+    BasicDaryHeap& operator=(const BasicDaryHeap &);
+    handle push(const T & elem, Key key);
+    T top();
+    void pop();
+    void decreaseKey(const T & elem, Key newKey);
+    void decreaseKey(handle h, Key newKey);
+    void erase(const T & elem);
+    void erase(handle h);
+    Key key(handle h);
+    bool contains(const T & elem);
+    size_t size();
+    bool empty();
+    void reserve(size_t n);
+    void clear();
+    ~BasicDaryHeap();
+
+private:
+    struct ClassVars;
+    ClassVars * ptr;
+
+    void copy(const BasicDaryHeap &);
+    size_t position(const T & elem);
+    void place(size_t pos, const std::pair<Key, T> & entry);
+    void siftUp(size_t pos);
+    void siftDown(size_t pos);
+    void removeAt(size_t pos);
+};
+
+// The index stores position + 1, so that 0 means absent.
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+struct BasicDaryHeap<T, Key, Compare, Hash, Arity>::ClassVars {
+    Compare compare;
+    std::vector<std::pair<Key, T>> entries;
+    heap_index<T, size_t, Hash> positions;
+};
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+BasicDaryHeap<T, Key, Compare, Hash, Arity>::BasicDaryHeap(Compare compare) {
+    static_assert(Arity >= 2, "a d-ary heap needs at least two children per node");
+
+    this->ptr = new ClassVars;
+    this->ptr->compare = compare;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+void BasicDaryHeap<T, Key, Compare, Hash, Arity>::copy(const BasicDaryHeap & other) {
+    this->ptr = new ClassVars(*other.ptr);
+}
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+BasicDaryHeap<T, Key, Compare, Hash, Arity>::BasicDaryHeap(const BasicDaryHeap & other) {
+    copy(other);
+}
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+BasicDaryHeap<T, Key, Compare, Hash, Arity> &
+BasicDaryHeap<T, Key, Compare, Hash, Arity>::operator=(const BasicDaryHeap & other) {
+    if (this == &other) return *this;
+
+    this->~BasicDaryHeap();
+    copy(other);
+    return *this;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+BasicDaryHeap<T, Key, Compare, Hash, Arity>::~BasicDaryHeap() {
+    delete this->ptr;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+void BasicDaryHeap<T, Key, Compare, Hash, Arity>::reserve(size_t n) {
+    this->ptr->entries.reserve(n);
+    this->ptr->positions.reserve(n);
+}
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+void BasicDaryHeap<T, Key, Compare, Hash, Arity>::clear() {
+    this->ptr->entries.clear();
+    this->ptr->positions.clear();
+}
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+bool BasicDaryHeap<T, Key, Compare, Hash, Arity>::contains(const T & elem) {
+    return this->ptr->positions.find(elem) != 0;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+size_t BasicDaryHeap<T, Key, Compare, Hash, Arity>::size() {
+    return this->ptr->entries.size();
+}
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+bool BasicDaryHeap<T, Key, Compare, Hash, Arity>::empty() {
+    return this->ptr->entries.empty();
+}
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+size_t BasicDaryHeap<T, Key, Compare, Hash, Arity>::position(const T & elem) {
+    size_t pos = this->ptr->positions.find(elem);
+    assert(pos != 0);
+
+    return pos - 1;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+void BasicDaryHeap<T, Key, Compare, Hash, Arity>::place(size_t pos, const std::pair<Key, T> & entry) {
+    this->ptr->entries[pos] = entry;
+    this->ptr->positions.insert(entry.second, pos + 1);
+}
+
+// Both sifts carry the moving entry in a local and shift the others over
+// it, writing it back once at its final position.
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+void BasicDaryHeap<T, Key, Compare, Hash, Arity>::siftUp(size_t pos) {
+    std::vector<std::pair<Key, T>> & entries = this->ptr->entries;
+    std::pair<Key, T> entry = entries[pos];
+
+    while (pos > 0) {
+        size_t parent = (pos - 1) / Arity;
+        if (!this->ptr->compare(entry.first, entries[parent].first)) break;
+
+        place(pos, entries[parent]);
+        pos = parent;
+    }
+
+    place(pos, entry);
+}
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+void BasicDaryHeap<T, Key, Compare, Hash, Arity>::siftDown(size_t pos) {
+    std::vector<std::pair<Key, T>> & entries = this->ptr->entries;
+    std::pair<Key, T> entry = entries[pos];
+    size_t n = entries.size();
+
+    while (true) {
+        size_t first = pos * Arity + 1;
+        if (first >= n) break;
+
+        size_t best = first;
+        size_t last = std::min(first + Arity, n);
+        for (size_t child = first + 1; child < last; child++) {
+            if (this->ptr->compare(entries[child].first, entries[best].first)) best = child;
+        }
+
+        if (!this->ptr->compare(entries[best].first, entry.first)) break;
+
+        place(pos, entries[best]);
+        pos = best;
+    }
+
+    place(pos, entry);
+}
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+void BasicDaryHeap<T, Key, Compare, Hash, Arity>::removeAt(size_t pos) {
+    std::vector<std::pair<Key, T>> & entries = this->ptr->entries;
+    this->ptr->positions.erase(entries[pos].second);
+
+    if (pos + 1 == entries.size()) {
+        entries.pop_back();
+        return;
+    }
+
+    // the last entry fills the hole and may need to move either way
+    T moved = entries.back().second;
+    entries[pos] = entries.back();
+    entries.pop_back();
+    siftDown(pos);
+    siftUp(position(moved));
+}
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+typename BasicDaryHeap<T, Key, Compare, Hash, Arity>::handle
+BasicDaryHeap<T, Key, Compare, Hash, Arity>::push(const T & elem, Key key) {
+    assert(!contains(elem));
+
+    this->ptr->entries.push_back(std::pair<Key, T>(key, elem));
+    siftUp(this->ptr->entries.size() - 1);
+
+    return handle{elem};
+}
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+T BasicDaryHeap<T, Key, Compare, Hash, Arity>::top() {
+    assert(!empty());
+
+    return this->ptr->entries[0].second;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+void BasicDaryHeap<T, Key, Compare, Hash, Arity>::pop() {
+    assert(!empty());
+
+    removeAt(0);
+}
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+void BasicDaryHeap<T, Key, Compare, Hash, Arity>::decreaseKey(const T & elem, Key newKey) {
+    size_t pos = position(elem);
+    assert(!this->ptr->compare(this->ptr->entries[pos].first, newKey));
+
+    this->ptr->entries[pos].first = newKey;
+    siftUp(pos);
+}
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+void BasicDaryHeap<T, Key, Compare, Hash, Arity>::decreaseKey(handle h, Key newKey) {
+    decreaseKey(h.elem, newKey);
+}
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+void BasicDaryHeap<T, Key, Compare, Hash, Arity>::erase(const T & elem) {
+    removeAt(position(elem));
+}
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+void BasicDaryHeap<T, Key, Compare, Hash, Arity>::erase(handle h) {
+    erase(h.elem);
+}
+
+template <typename T, typename Key, typename Compare, typename Hash, size_t Arity>
+Key BasicDaryHeap<T, Key, Compare, Hash, Arity>::key(handle h) {
+    return this->ptr->entries[position(h.elem)].first;
+}
+
+#endif
@@ -8,12 +8,18 @@ class DisjointSet {
 public:
     DisjointSet();
     DisjointSet(std::vector<std::string> & vec);
+    // Dense mode: the elements are the integers 0..n-1, kept in flat
+    // arrays instead of a node per string.
+    DisjointSet(size_t n);
     DisjointSet(const DisjointSet &);
     DisjointSet& operator=(const DisjointSet &);
     void insert(std::string x);
     std::string find(std::string x);
+    size_t find(size_t x);
     bool contains(std::string x);
+    bool contains(size_t x);
     void setUnion(std::string x, std::string y);
+    void setUnion(size_t x, size_t y);
     size_t size();
     bool empty();
     ~DisjointSet();
@@ -1,27 +1,448 @@
 #ifndef FIBHEAP_H
 #define FIBHEAP_H
 
+#include <algorithm>
+#include <functional>
 #include <string>
+#include <utility>
+#include <vector>
+#include <assert.h>
 
-class FibonacciHeap {
+#include "heap_common.h"
+
+// Ascending order, or descending when built from reverse = true. This is
+// the comparator of the FibonacciHeap alias, which takes the flag at
+// runtime; heaps with a fixed order should use std::less / std::greater.
+template <typename Key>
+struct fib_compare {
+    bool reverse;
+
+    fib_compare(bool reverse = false) : reverse(reverse) {}
+
+    bool operator()(const Key & a, const Key & b) const {
+        return reverse ? b < a : a < b;
+    }
+};
+
+// Fibonacci heap over elements of type T, each pushed at most once and
+// found again through a hash map (or a flat array, see heap_dense_index).
+// top() is the element whose key comes first under Compare.
+template <
+    typename T,
+    typename Key = float,
+    typename Compare = std::less<Key>,
+    typename Hash = std::hash<T>
+>
+class BasicFibonacciHeap {
 public:
-    FibonacciHeap(bool reverse = false);
-    FibonacciHeap(const FibonacciHeap &);
-    FibonacciHeap& operator=(const FibonacciHeap &);
-    void push(std::string elem, float key);
-    std::string top();
+    struct Node;
+    // Returned by push() and valid until its element is popped or erased,
+    // or the heap is cleared. Operations on a handle skip the node lookup.
+    typedef Node * handle;
+
+    BasicFibonacciHeap(Compare compare = Compare());
+    BasicFibonacciHeap(const BasicFibonacciHeap &);
+    BasicFibonacciHeap& operator=(const BasicFibonacciHeap &);
+    handle push(const T & elem, Key key);
+    T top();
     void pop();
-    void decreaseKey(std::string elem, float newKey);
-    bool contains(std::string elem);
+    void decreaseKey(const T & elem, Key newKey);
+    void decreaseKey(handle node, Key newKey);
+    void erase(const T & elem);
+    void erase(handle node);
+    Key key(handle node);
+    bool contains(const T & elem);
     size_t size();
     bool empty();
-    ~FibonacciHeap();
+    // Preallocates nodes for n elements.
+    void reserve(size_t n);
+    // Empties the heap but keeps its node storage for reuse.
+    void clear();
+    ~BasicFibonacciHeap();
 
 private:
-    void consolidate();
-    void copy(const FibonacciHeap &);
     struct ClassVars;
     ClassVars * ptr;
+
+    void consolidate();
+    void copy(const BasicFibonacciHeap &);
+    Node * getMinNode(Node * a, Node * b);
+    void addRoot(Node * node);
+    void cascadingCut(Node * node);
+
+    static std::pair<Node *, Node *> removeNode(Node * node, Node * head, Node * tail);
+    static void attachChildNode(Node * mainNode, Node * childNode);
+    static std::pair<Node *, Node *> bumpNodeChildren(Node * node, Node * head, Node * tail);
+    static void cut(Node * node, Node * parent);
 };
 
-#endif
\ No newline at end of file
+typedef BasicFibonacciHeap<std::string, float, fib_compare<float>> FibonacciHeap;
+
+template <typename T, typename Key, typename Compare, typename Hash>
+struct BasicFibonacciHeap<T, Key, Compare, Hash>::Node {
+    T elem;
+    Key key;
+    Node * parent;
+    Node * next;
+    Node * prev;
+    Node * childHead;
+    Node * childTail;
+    size_t rank;
+    bool marked;
+};
+
+template <typename T, typename Key, typename Compare, typename Hash>
+struct BasicFibonacciHeap<T, Key, Compare, Hash>::ClassVars {
+    size_t size;
+    Compare compare;
+    Node * minNode;
+    Node * rootHead;
+    Node * rootTail;
+    heap_index<T, Node *, Hash> nodeMap;
+    heap_node_pool<Node> pool;
+    std::vector<Node *> rankTable;
+};
+
+template <typename T, typename Key, typename Compare, typename Hash>
+BasicFibonacciHeap<T, Key, Compare, Hash>::BasicFibonacciHeap(Compare compare) {
+    this->ptr = new ClassVars;
+    this->ptr->size = 0;
+    this->ptr->compare = compare;
+    this->ptr->minNode = NULL;
+    this->ptr->rootHead = NULL;
+    this->ptr->rootTail = NULL;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicFibonacciHeap<T, Key, Compare, Hash>::copy(const BasicFibonacciHeap & other) {
+    this->ptr = new ClassVars;
+    this->ptr->size = 0;
+    this->ptr->compare = other.ptr->compare;
+    this->ptr->minNode = NULL;
+    this->ptr->rootHead = NULL;
+    this->ptr->rootTail = NULL;
+    reserve(other.ptr->size);
+
+    // the copy keeps the same elements and keys but starts with every
+    // node as a root; handles into the original do not carry over
+    std::vector<Node *> stack;
+    for (Node * root = other.ptr->rootHead; root != NULL; root = root->next) {
+        stack.push_back(root);
+    }
+
+    while (!stack.empty()) {
+        Node * node = stack.back();
+        stack.pop_back();
+        this->push(node->elem, node->key);
+
+        for (Node * child = node->childHead; child != NULL; child = child->next) {
+            stack.push_back(child);
+        }
+    }
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+BasicFibonacciHeap<T, Key, Compare, Hash>::BasicFibonacciHeap(const BasicFibonacciHeap & other) {
+    copy(other);
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+BasicFibonacciHeap<T, Key, Compare, Hash> &
+BasicFibonacciHeap<T, Key, Compare, Hash>::operator=(const BasicFibonacciHeap & other) {
+    if (this == &other) return *this;
+
+    this->~BasicFibonacciHeap();
+    copy(other);
+    return *this;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+BasicFibonacciHeap<T, Key, Compare, Hash>::~BasicFibonacciHeap() {
+    delete this->ptr;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicFibonacciHeap<T, Key, Compare, Hash>::reserve(size_t n) {
+    this->ptr->pool.reserve(n);
+    this->ptr->nodeMap.reserve(n);
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicFibonacciHeap<T, Key, Compare, Hash>::clear() {
+    this->ptr->size = 0;
+    this->ptr->minNode = NULL;
+    this->ptr->rootHead = NULL;
+    this->ptr->rootTail = NULL;
+    this->ptr->nodeMap.clear();
+    this->ptr->pool.clear();
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+bool BasicFibonacciHeap<T, Key, Compare, Hash>::contains(const T & elem) {
+    return this->ptr->nodeMap.find(elem) != NULL;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+typename BasicFibonacciHeap<T, Key, Compare, Hash>::Node *
+BasicFibonacciHeap<T, Key, Compare, Hash>::getMinNode(Node * a, Node * b) {
+    return this->ptr->compare(a->key, b->key) ? a : b;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicFibonacciHeap<T, Key, Compare, Hash>::addRoot(Node * node) {
+    node->parent = NULL;
+    node->next = NULL;
+    node->prev = this->ptr->rootTail;
+
+    if (this->ptr->rootTail == NULL) this->ptr->rootHead = node;
+    else this->ptr->rootTail->next = node;
+    this->ptr->rootTail = node;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+typename BasicFibonacciHeap<T, Key, Compare, Hash>::handle
+BasicFibonacciHeap<T, Key, Compare, Hash>::push(const T & elem, Key key) {
+    assert(!contains(elem));
+
+    Node * node = this->ptr->pool.allocate();
+    node->elem = elem;
+    node->key = key;
+    node->childHead = NULL;
+    node->childTail = NULL;
+    node->rank = 0;
+    node->marked = false;
+
+    this->ptr->nodeMap.insert(elem, node);
+    this->ptr->size++;
+    addRoot(node);
+
+    if (this->ptr->size == 1) this->ptr->minNode = node;
+    else this->ptr->minNode = getMinNode(this->ptr->minNode, node);
+
+    return node;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+T BasicFibonacciHeap<T, Key, Compare, Hash>::top() {
+    assert(size() > 0);
+
+    return this->ptr->minNode->elem;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+size_t BasicFibonacciHeap<T, Key, Compare, Hash>::size() {
+    return this->ptr->size;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+bool BasicFibonacciHeap<T, Key, Compare, Hash>::empty() {
+    return this->ptr->size == 0;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+std::pair<typename BasicFibonacciHeap<T, Key, Compare, Hash>::Node *, typename BasicFibonacciHeap<T, Key, Compare, Hash>::Node *>
+BasicFibonacciHeap<T, Key, Compare, Hash>::removeNode(Node * node, Node * head, Node * tail) {
+    if (node == NULL) return {head, tail};
+
+    Node * back = node->prev;
+    Node * front = node->next;
+    node->next = NULL;
+    node->prev = NULL;
+
+    if (back != NULL && front != NULL) {
+        back->next = front;
+        front->prev = back;
+        return {head, tail};
+    } else if (back == NULL && front == NULL) {
+        return {NULL, NULL};
+    } else if (back == NULL && front != NULL) {
+        front->prev = NULL;
+        return {front, tail};
+    } else {
+        back->next = NULL;
+        return {head, back};
+    }
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicFibonacciHeap<T, Key, Compare, Hash>::attachChildNode(Node * mainNode, Node * childNode) {
+    childNode->parent = mainNode;
+
+    if (mainNode->rank == 0) {
+        mainNode->childHead = childNode;
+        mainNode->childTail = childNode;
+    } else {
+        mainNode->childTail->next = childNode;
+        childNode->prev = mainNode->childTail;
+        mainNode->childTail = childNode;
+    }
+
+    mainNode->rank++;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+std::pair<typename BasicFibonacciHeap<T, Key, Compare, Hash>::Node *, typename BasicFibonacciHeap<T, Key, Compare, Hash>::Node *>
+BasicFibonacciHeap<T, Key, Compare, Hash>::bumpNodeChildren(Node * node, Node * head, Node * tail) {
+    assert(node != NULL);
+
+    Node * childHead = node->childHead;
+    Node * childTail = node->childTail;
+
+    if (head == NULL) return {childHead, childTail};
+    if (childHead == NULL) return {head, tail};
+
+    tail->next = childHead;
+    childHead->prev = tail;
+
+    return {head, childTail};
+}
+
+// A root of rank r has at least F(r + 2) descendants, so ranks stay
+// below log_phi(n) + 2, which 2 * bit_width(n) + 2 covers.
+inline size_t fibRankBound(size_t n) {
+    size_t bound = 2;
+    for (; n > 0; n >>= 1) bound += 2;
+
+    return bound;
+}
+
+// Links roots of equal rank in one pass over the root list, then rebuilds
+// the list from the rank table. Stale parent pointers left by pop() are
+// cleared as each root is detached.
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicFibonacciHeap<T, Key, Compare, Hash>::consolidate() {
+    std::vector<Node *> & ranks = this->ptr->rankTable;
+    if (ranks.size() < fibRankBound(this->ptr->size)) {
+        ranks.resize(fibRankBound(this->ptr->size), NULL);
+    }
+
+    size_t maxRank = 0;
+    Node * ptr = this->ptr->rootHead;
+
+    while (ptr != NULL) {
+        Node * node = ptr;
+        ptr = ptr->next;
+        node->parent = NULL;
+        node->prev = NULL;
+        node->next = NULL;
+
+        while (ranks[node->rank] != NULL) {
+            Node * otherNode = ranks[node->rank];
+            ranks[node->rank] = NULL;
+
+            if (this->ptr->compare(otherNode->key, node->key)) std::swap(node, otherNode);
+            attachChildNode(node, otherNode);
+        }
+
+        ranks[node->rank] = node;
+        maxRank = std::max(maxRank, node->rank);
+    }
+
+    this->ptr->rootHead = NULL;
+    this->ptr->rootTail = NULL;
+    this->ptr->minNode = NULL;
+
+    for (size_t rank = 0; rank <= maxRank; rank++) {
+        Node * node = ranks[rank];
+        if (node == NULL) continue;
+        ranks[rank] = NULL;
+
+        addRoot(node);
+        if (this->ptr->minNode == NULL) this->ptr->minNode = node;
+        else this->ptr->minNode = getMinNode(this->ptr->minNode, node);
+    }
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicFibonacciHeap<T, Key, Compare, Hash>::pop() {
+    assert(!empty());
+
+    Node * minNode = this->ptr->minNode;
+    this->ptr->nodeMap.erase(minNode->elem);
+    this->ptr->size--;
+
+    std::pair<Node *, Node *> p = removeNode(minNode, this->ptr->rootHead, this->ptr->rootTail);
+    p = bumpNodeChildren(minNode, p.first, p.second);
+    this->ptr->rootHead = p.first;
+    this->ptr->rootTail = p.second;
+    this->ptr->pool.release(minNode);
+
+    consolidate();
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicFibonacciHeap<T, Key, Compare, Hash>::cut(Node * node, Node * parent) {
+    std::pair<Node *, Node *> p = removeNode(node, parent->childHead, parent->childTail);
+    parent->childHead = p.first;
+    parent->childTail = p.second;
+
+    parent->rank--;
+}
+
+// Moves node to the root list, then walks up cutting marked ancestors
+// and marking the first unmarked one.
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicFibonacciHeap<T, Key, Compare, Hash>::cascadingCut(Node * node) {
+    Node * parent = node->parent;
+
+    while (parent != NULL) {
+        cut(node, parent);
+        addRoot(node);
+        node->marked = false;
+
+        node = parent;
+        parent = parent->parent;
+        if (parent != NULL && !node->marked) {
+            node->marked = true;
+            break;
+        }
+    }
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicFibonacciHeap<T, Key, Compare, Hash>::decreaseKey(handle node, Key newKey) {
+    assert(node != NULL);
+    assert(!this->ptr->compare(node->key, newKey));
+    if (!this->ptr->compare(newKey, node->key)) return;
+
+    node->key = newKey;
+    Node * parent = node->parent;
+    if (parent != NULL && !this->ptr->compare(newKey, parent->key)) return;
+    if (parent != NULL) cascadingCut(node);
+
+    this->ptr->minNode = getMinNode(this->ptr->minNode, node);
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicFibonacciHeap<T, Key, Compare, Hash>::decreaseKey(const T & elem, Key newKey) {
+    assert(contains(elem));
+
+    decreaseKey(this->ptr->nodeMap.find(elem), newKey);
+}
+
+// Cuts the node up to the root list as if its key had dropped below every
+// other, then pops it.
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicFibonacciHeap<T, Key, Compare, Hash>::erase(handle node) {
+    assert(node != NULL);
+
+    if (node->parent != NULL) cascadingCut(node);
+    this->ptr->minNode = node;
+    pop();
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicFibonacciHeap<T, Key, Compare, Hash>::erase(const T & elem) {
+    assert(contains(elem));
+
+    erase(this->ptr->nodeMap.find(elem));
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+Key BasicFibonacciHeap<T, Key, Compare, Hash>::key(handle node) {
+    assert(node != NULL);
+
+    return node->key;
+}
+
+#endif
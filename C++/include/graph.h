@@ -3,39 +3,136 @@
 
 #include <unordered_set>
 #include <unordered_map>
+#include <functional>
+#include <shared_mutex>
+#include <mutex>
 #include <string>
+#include <tuple>
 #include <vector>
+#include <cstdint>
 
 class Graph {
 public:
-    Graph(bool directed, bool weighted);
+    enum MstAlgorithm {
+        PRIM,
+        KRUSKAL,
+        BORUVKA
+    };
+
+    // Priority queues that dijkstra() and Prim's mst() can run on, keyed by
+    // vertex id. RadixQueue relies on keys never dropping below the last
+    // one popped, so it is only available to dijkstra().
+    struct FibonacciQueue {};
+    struct PairingQueue {};
+    struct DaryQueue {};
+    struct RadixQueue {};
+
+    struct Neighbor {
+        uint32_t id;
+        float edgeValue;
+    };
+
+    // Borrowed range over a vertex's adjacency entries. Any mutation of
+    // the graph invalidates it.
+    class NeighborView {
+    public:
+        NeighborView(const Neighbor * first, const Neighbor * last);
+        const Neighbor * begin() const;
+        const Neighbor * end() const;
+        size_t size() const;
+        bool empty() const;
+
+    private:
+        const Neighbor * first;
+        const Neighbor * last;
+    };
+
+    Graph(bool directed, bool weighted, bool reverseIndexed = false);
     Graph(const Graph &);
     Graph& operator=(const Graph &);
-    Graph reverse();
-    bool empty();
-    std::unordered_set<std::string> getVertices();
-    std::unordered_map<std::string, std::unordered_set<std::string>> getEdges();
-    bool isAdjacent(std::string a, std::string b);
+    // Const methods never modify the graph, so any number of threads may
+    // call them at once. While a writer is active, readers hold readLock()
+    // and the writer holds writeLock() around each batch of updates.
+    std::shared_lock<std::shared_mutex> readLock() const;
+    std::unique_lock<std::shared_mutex> writeLock();
+    Graph reverse() const;
+    bool empty() const;
+    bool isDirected() const;
+    bool isWeighted() const;
+    bool isReverseIndexed() const;
+    std::unordered_set<std::string> getVertices() const;
+    std::unordered_map<std::string, std::unordered_set<std::string>> getEdges() const;
+    uint32_t getId(std::string v) const;
+    std::string getVertex(uint32_t id) const;
+    bool isAdjacent(std::string a, std::string b) const;
+    bool isAdjacent(uint32_t a, uint32_t b) const;
     void flipEdge(std::string a, std::string b);
-    std::unordered_set<std::string> getNeighbors(std::string v);
-    std::unordered_set<std::string> getIncomingNeighbors(std::string v);
-    bool isSourceVertex(std::string v);
-    bool isSinkVertex(std::string v);
-    bool hasVertex(std::string v);
-    void addVertex(std::string v);
+    std::unordered_set<std::string> getNeighbors(std::string v) const;
+    std::unordered_set<uint32_t> getNeighborIds(uint32_t v) const;
+    NeighborView neighbors(std::string v) const;
+    NeighborView neighbors(uint32_t v) const;
+    void forEachVertex(std::function<void(const std::string &)> callback) const;
+    void forEachNeighbor(std::string v, std::function<void(const std::string &, float)> callback) const;
+    void forEachEdge(std::function<void(const std::string &, const std::string &, float)> callback) const;
+    std::unordered_set<std::string> getIncomingNeighbors(std::string v) const;
+    NeighborView incomingNeighbors(std::string v) const;
+    NeighborView incomingNeighbors(uint32_t v) const;
+    size_t getInDegree(std::string v) const;
+    size_t getOutDegree(std::string v) const;
+    bool isSourceVertex(std::string v) const;
+    bool isSinkVertex(std::string v) const;
+    bool hasVertex(std::string v) const;
+    bool hasVertex(uint32_t id) const;
+    uint32_t addVertex(std::string v);
     void addEdge(std::string a, std::string b, float edgeValue = 0);
+    void addEdge(uint32_t a, uint32_t b, float edgeValue = 0);
+    // Same result as calling addEdge for each (a, b, edgeValue) in order,
+    // but edges are grouped by source before any list is touched, and
+    // empty lists are built in one pass. New entries end up in id order.
+    void addEdges(const std::vector<std::tuple<std::string, std::string, float>> & edges);
+    // Writes the graph in the CompactGraph file format; CompactGraph::load
+    // maps it back in. Throws std::runtime_error if the file cannot be
+    // written.
+    void save(std::string path) const;
+    static Graph fromEdges(bool directed, bool weighted, const std::vector<std::tuple<std::string, std::string, float>> & edges, bool reverseIndexed = false);
     void removeVertex(std::string v);
     void removeEdge(std::string a, std::string b);
-    float getEdgeValue(std::string a, std::string b);
+    void removeEdge(uint32_t a, uint32_t b);
+    float getEdgeValue(std::string a, std::string b) const;
+    float getEdgeValue(uint32_t a, uint32_t b) const;
     void setEdgeValue(std::string a, std::string b, float edgeValue);
-    std::vector<std::string> dfs(std::string v);
-    std::vector<std::string> bfs(std::string v);
-    std::pair<std::unordered_map<std::string, float>, std::unordered_map<std::string, std::string>> dijkstra(std::string v);
-    std::pair<std::unordered_map<std::string, float>, std::unordered_map<std::string, std::string>> bellmanFord(std::string v);
-    std::pair<std::vector<std::vector<float>>, std::vector<std::vector<int>>> floydWarshall();
-    std::vector<std::pair<std::string, std::string>> mst();
-    std::vector<std::string> topologicalSort();
-    std::vector<std::unordered_set<std::string>> stronglyConnectedComponents();
+    void setEdgeValue(uint32_t a, uint32_t b, float edgeValue);
+    std::vector<std::string> dfs(std::string v) const;
+    std::vector<std::string> bfs(std::string v) const;
+    template <typename Queue = FibonacciQueue>
+    std::pair<std::unordered_map<std::string, float>, std::unordered_map<std::string, std::string>> dijkstra(std::string v) const;
+    std::pair<std::vector<std::string>, float> shortestPath(std::string source, std::string target) const;
+    std::pair<std::vector<std::string>, float> bidirectionalShortestPath(std::string source, std::string target) const;
+    std::pair<std::vector<std::string>, float> aStar(std::string source, std::string target, std::function<float(const std::string &)> heuristic) const;
+    std::pair<std::unordered_map<std::string, float>, std::unordered_map<std::string, std::string>> bellmanFord(std::string v) const;
+    // Returns empty maps if a negative cycle is reachable from v; the
+    // cycle itself is listed by negativeCycle().
+    std::pair<std::unordered_map<std::string, float>, std::unordered_map<std::string, std::string>> spfa(std::string v) const;
+    std::vector<std::string> negativeCycle() const;
+    std::pair<std::vector<std::vector<float>>, std::vector<std::vector<int>>> floydWarshall(size_t threads = 1) const;
+    // Returns empty matrices if the graph has a negative cycle; the
+    // cycle itself is listed by negativeCycle().
+    std::pair<std::vector<std::vector<float>>, std::vector<std::vector<int>>> johnson(size_t threads = 1) const;
+    // Streams one row of johnson() per source instead of holding the whole
+    // matrix. Calls are serialized but arrive in no particular order, and
+    // there are none if the graph has a negative cycle.
+    void johnson(std::function<void(const std::string &, const std::vector<float> &, const std::vector<int> &)> callback, size_t threads = 1) const;
+    // Minimum spanning forest: one tree per connected component.
+    template <typename Queue = FibonacciQueue>
+    std::vector<std::pair<std::string, std::string>> mst(MstAlgorithm algorithm = PRIM, size_t threads = 1) const;
+    std::vector<std::string> topologicalSort() const;
+    std::vector<std::unordered_set<std::string>> stronglyConnectedComponents() const;
+    // Strongly connected component of every vertex id (see getId), numbered
+    // densely in topological order of the condensation, and the number of
+    // components.
+    std::pair<std::vector<uint32_t>, size_t> componentIds() const;
+    // DAG with one vertex per component, named by its component id.
+    Graph condensation() const;
     ~Graph();
 
 private:
@@ -43,4 +140,26 @@ private:
     ClassVars * ptr;
 };
 
+// Incremental topological order over a directed graph: vertices become
+// ready once every predecessor has been completed, so work can be
+// dispatched before the whole order is known. The graph must not be
+// modified while a scheduler is in use.
+class TopologicalScheduler {
+public:
+    TopologicalScheduler(const Graph & g);
+    TopologicalScheduler(const TopologicalScheduler &);
+    TopologicalScheduler& operator=(const TopologicalScheduler &);
+    bool hasReady();
+    std::string next();
+    void complete(std::string v);
+    size_t inFlight();
+    bool done();
+    bool hasCycle();
+    ~TopologicalScheduler();
+
+private:
+    struct ClassVars;
+    ClassVars * ptr;
+};
+
 #endif
\ No newline at end of file
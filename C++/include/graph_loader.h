@@ -0,0 +1,43 @@
+#ifndef GRAPH_LOADER_H
+#define GRAPH_LOADER_H
+
+#include <string>
+
+#include "graph.h"
+
+// Streams an edge file into a Graph one chunk at a time. Each chunk is
+// cut at a line boundary, split across threads for parsing, and handed
+// to Graph::addEdges in file order, so memory use is bounded by the
+// chunk size rather than the file size. A file that cannot be read, or a
+// malformed line, throws std::runtime_error naming the path and line; the
+// graph then holds the edges read before that line.
+//
+// EDGE_LIST: "u v [w]" per line, '#' or '%' comment lines.
+// SNAP:      an alias of EDGE_LIST; SNAP collection files are edge lists.
+// DIMACS:    9th DIMACS challenge .gr files ("c", "p sp n m", "a u v w").
+//            The problem line adds vertices "1" to "n", isolated or not.
+class GraphLoader {
+public:
+    enum Format {
+        EDGE_LIST,
+        SNAP = EDGE_LIST,
+        DIMACS
+    };
+
+    GraphLoader(Format format, size_t threads = 0, size_t chunkBytes = 1 << 24);
+    GraphLoader(const GraphLoader &);
+    GraphLoader& operator=(const GraphLoader &);
+    Graph load(std::string path, bool directed, bool weighted);
+    void load(std::string path, Graph & g);
+    size_t edgesLoaded();
+    size_t bytesRead();
+    double seconds();
+    double edgesPerSecond();
+    ~GraphLoader();
+
+private:
+    struct ClassVars;
+    ClassVars * ptr;
+};
+
+#endif
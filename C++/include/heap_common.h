@@ -0,0 +1,102 @@
+#ifndef HEAP_COMMON_H
+#define HEAP_COMMON_H
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Building blocks shared by the addressable heaps (fibheap.h,
+// pairing_heap.h, dary_heap.h, radix_heap.h). Every heap there offers the
+// same operations: push() returning a handle, top, pop, decreaseKey and
+// erase by element or handle, key(handle), contains, size, empty, reserve
+// and clear.
+
+// Passed as Hash for elements that are small dense integers (such as
+// vertex ids): per-element state then lives in a flat array indexed by
+// the element, with no hashing at all.
+struct heap_dense_index {};
+
+// Maps each element in a heap to a value of type V (a node pointer, a
+// position, ...). A value-initialized V means the element is absent.
+template <typename T, typename V, typename Hash>
+struct heap_index {
+    std::unordered_map<T, V, Hash> values;
+
+    V find(const T & elem) const {
+        typename std::unordered_map<T, V, Hash>::const_iterator it = values.find(elem);
+        return it == values.end() ? V() : it->second;
+    }
+
+    void insert(const T & elem, V value) { values[elem] = value; }
+    void erase(const T & elem) { values.erase(elem); }
+    void reserve(size_t n) { values.reserve(n); }
+    void clear() { values.clear(); }
+};
+
+template <typename T, typename V>
+struct heap_index<T, V, heap_dense_index> {
+    std::vector<V> values;
+
+    V find(const T & elem) const {
+        size_t i = static_cast<size_t>(elem);
+        return i < values.size() ? values[i] : V();
+    }
+
+    void insert(const T & elem, V value) {
+        size_t i = static_cast<size_t>(elem);
+        if (i >= values.size()) values.resize(std::max(i + 1, 2 * values.size()), V());
+        values[i] = value;
+    }
+
+    void erase(const T & elem) { values[static_cast<size_t>(elem)] = V(); }
+    void reserve(size_t n) { if (values.size() < n) values.resize(n, V()); }
+    void clear() { std::fill(values.begin(), values.end(), V()); }
+};
+
+// Nodes are carved out of fixed-size slabs that live as long as the
+// heap. Released nodes go on a free list (threaded through their 'next'
+// pointer) and are handed out again before the slabs grow, and clear()
+// rewinds the slabs without freeing them. A recycled node keeps its
+// element's storage.
+const size_t HEAP_SLAB_SIZE = 1024;
+
+template <typename Node>
+struct heap_node_pool {
+    std::vector<std::unique_ptr<Node[]>> slabs;
+    size_t used = 0;
+    Node * freeList = NULL;
+
+    void reserve(size_t capacity) {
+        while (slabs.size() * HEAP_SLAB_SIZE < capacity) {
+            slabs.push_back(std::unique_ptr<Node[]>(new Node[HEAP_SLAB_SIZE]));
+        }
+    }
+
+    Node * allocate() {
+        if (freeList != NULL) {
+            Node * node = freeList;
+            freeList = node->next;
+            return node;
+        }
+
+        reserve(used + 1);
+        Node * node = &slabs[used / HEAP_SLAB_SIZE][used % HEAP_SLAB_SIZE];
+        used++;
+
+        return node;
+    }
+
+    void release(Node * node) {
+        node->next = freeList;
+        freeList = node;
+    }
+
+    void clear() {
+        used = 0;
+        freeList = NULL;
+    }
+};
+
+#endif
@@ -0,0 +1,306 @@
+#ifndef PAIRING_HEAP_H
+#define PAIRING_HEAP_H
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+#include <assert.h>
+
+#include "heap_common.h"
+
+// Pairing heap with the same interface as BasicFibonacciHeap. Children
+// hang off their parent in a sibling list; pop() melds them back with the
+// two-pass rule, and decreaseKey() cuts the subtree and melds it with the
+// root, so both are a couple of pointer swaps outside of pop().
+template <
+    typename T,
+    typename Key = float,
+    typename Compare = std::less<Key>,
+    typename Hash = std::hash<T>
+>
+class BasicPairingHeap {
+public:
+    struct Node;
+    // Returned by push() and valid until its element is popped or erased,
+    // or the heap is cleared.
+    typedef Node * handle;
+
+    BasicPairingHeap(Compare compare = Compare());
+    BasicPairingHeap(const BasicPairingHeap &);
+    BasicPairingHeap& operator=(const BasicPairingHeap &);
+    handle push(const T & elem, Key key);
+    T top();
+    void pop();
+    void decreaseKey(const T & elem, Key newKey);
+    void decreaseKey(handle node, Key newKey);
+    void erase(const T & elem);
+    void erase(handle node);
+    Key key(handle node);
+    bool contains(const T & elem);
+    size_t size();
+    bool empty();
+    // Preallocates nodes for n elements.
+    void reserve(size_t n);
+    // Empties the heap but keeps its node storage for reuse.
+    void clear();
+    ~BasicPairingHeap();
+
+private:
+    struct ClassVars;
+    ClassVars * ptr;
+
+    void copy(const BasicPairingHeap &);
+    Node * link(Node * a, Node * b);
+    Node * mergePairs(Node * first);
+
+    static void detach(Node * node);
+};
+
+// 'prev' is the left sibling, or the parent for a first child.
+template <typename T, typename Key, typename Compare, typename Hash>
+struct BasicPairingHeap<T, Key, Compare, Hash>::Node {
+    T elem;
+    Key key;
+    Node * child;
+    Node * next;
+    Node * prev;
+};
+
+template <typename T, typename Key, typename Compare, typename Hash>
+struct BasicPairingHeap<T, Key, Compare, Hash>::ClassVars {
+    size_t size;
+    Compare compare;
+    Node * root;
+    heap_index<T, Node *, Hash> nodeMap;
+    heap_node_pool<Node> pool;
+    std::vector<Node *> pairs;
+};
+
+template <typename T, typename Key, typename Compare, typename Hash>
+BasicPairingHeap<T, Key, Compare, Hash>::BasicPairingHeap(Compare compare) {
+    this->ptr = new ClassVars;
+    this->ptr->size = 0;
+    this->ptr->compare = compare;
+    this->ptr->root = NULL;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicPairingHeap<T, Key, Compare, Hash>::copy(const BasicPairingHeap & other) {
+    this->ptr = new ClassVars;
+    this->ptr->size = 0;
+    this->ptr->compare = other.ptr->compare;
+    this->ptr->root = NULL;
+    reserve(other.ptr->size);
+
+    std::vector<Node *> stack;
+    if (other.ptr->root != NULL) stack.push_back(other.ptr->root);
+
+    while (!stack.empty()) {
+        Node * node = stack.back();
+        stack.pop_back();
+        this->push(node->elem, node->key);
+
+        for (Node * child = node->child; child != NULL; child = child->next) {
+            stack.push_back(child);
+        }
+    }
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+BasicPairingHeap<T, Key, Compare, Hash>::BasicPairingHeap(const BasicPairingHeap & other) {
+    copy(other);
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+BasicPairingHeap<T, Key, Compare, Hash> &
+BasicPairingHeap<T, Key, Compare, Hash>::operator=(const BasicPairingHeap & other) {
+    if (this == &other) return *this;
+
+    this->~BasicPairingHeap();
+    copy(other);
+    return *this;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+BasicPairingHeap<T, Key, Compare, Hash>::~BasicPairingHeap() {
+    delete this->ptr;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicPairingHeap<T, Key, Compare, Hash>::reserve(size_t n) {
+    this->ptr->pool.reserve(n);
+    this->ptr->nodeMap.reserve(n);
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicPairingHeap<T, Key, Compare, Hash>::clear() {
+    this->ptr->size = 0;
+    this->ptr->root = NULL;
+    this->ptr->nodeMap.clear();
+    this->ptr->pool.clear();
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+bool BasicPairingHeap<T, Key, Compare, Hash>::contains(const T & elem) {
+    return this->ptr->nodeMap.find(elem) != NULL;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+size_t BasicPairingHeap<T, Key, Compare, Hash>::size() {
+    return this->ptr->size;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+bool BasicPairingHeap<T, Key, Compare, Hash>::empty() {
+    return this->ptr->size == 0;
+}
+
+// Makes the root with the later key the first child of the other, and
+// returns the new root. Both arguments must be detached roots.
+template <typename T, typename Key, typename Compare, typename Hash>
+typename BasicPairingHeap<T, Key, Compare, Hash>::Node *
+BasicPairingHeap<T, Key, Compare, Hash>::link(Node * a, Node * b) {
+    if (this->ptr->compare(b->key, a->key)) std::swap(a, b);
+
+    b->prev = a;
+    b->next = a->child;
+    if (a->child != NULL) a->child->prev = b;
+    a->child = b;
+
+    return a;
+}
+
+// Two-pass pairing: link siblings in pairs from the left, then fold the
+// results into one tree from the right.
+template <typename T, typename Key, typename Compare, typename Hash>
+typename BasicPairingHeap<T, Key, Compare, Hash>::Node *
+BasicPairingHeap<T, Key, Compare, Hash>::mergePairs(Node * first) {
+    std::vector<Node *> & pairs = this->ptr->pairs;
+    pairs.clear();
+
+    while (first != NULL) {
+        Node * a = first;
+        Node * b = a->next;
+        a->prev = NULL;
+        a->next = NULL;
+
+        if (b == NULL) {
+            pairs.push_back(a);
+            break;
+        }
+
+        first = b->next;
+        b->prev = NULL;
+        b->next = NULL;
+        pairs.push_back(link(a, b));
+    }
+
+    if (pairs.empty()) return NULL;
+
+    Node * root = pairs.back();
+    for (size_t i = pairs.size() - 1; i > 0; i--) {
+        root = link(pairs[i - 1], root);
+    }
+
+    return root;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicPairingHeap<T, Key, Compare, Hash>::detach(Node * node) {
+    if (node->prev->child == node) node->prev->child = node->next;
+    else node->prev->next = node->next;
+
+    if (node->next != NULL) node->next->prev = node->prev;
+    node->prev = NULL;
+    node->next = NULL;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+typename BasicPairingHeap<T, Key, Compare, Hash>::handle
+BasicPairingHeap<T, Key, Compare, Hash>::push(const T & elem, Key key) {
+    assert(!contains(elem));
+
+    Node * node = this->ptr->pool.allocate();
+    node->elem = elem;
+    node->key = key;
+    node->child = NULL;
+    node->next = NULL;
+    node->prev = NULL;
+
+    this->ptr->nodeMap.insert(elem, node);
+    this->ptr->size++;
+    this->ptr->root = this->ptr->root == NULL ? node : link(this->ptr->root, node);
+
+    return node;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+T BasicPairingHeap<T, Key, Compare, Hash>::top() {
+    assert(!empty());
+
+    return this->ptr->root->elem;
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicPairingHeap<T, Key, Compare, Hash>::pop() {
+    assert(!empty());
+
+    Node * root = this->ptr->root;
+    this->ptr->nodeMap.erase(root->elem);
+    this->ptr->size--;
+    this->ptr->root = mergePairs(root->child);
+    this->ptr->pool.release(root);
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicPairingHeap<T, Key, Compare, Hash>::decreaseKey(handle node, Key newKey) {
+    assert(node != NULL);
+    assert(!this->ptr->compare(node->key, newKey));
+
+    node->key = newKey;
+    if (node == this->ptr->root) return;
+
+    detach(node);
+    this->ptr->root = link(this->ptr->root, node);
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicPairingHeap<T, Key, Compare, Hash>::decreaseKey(const T & elem, Key newKey) {
+    assert(contains(elem));
+
+    decreaseKey(this->ptr->nodeMap.find(elem), newKey);
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicPairingHeap<T, Key, Compare, Hash>::erase(handle node) {
+    assert(node != NULL);
+    if (node == this->ptr->root) {
+        pop();
+        return;
+    }
+
+    detach(node);
+    Node * subtree = mergePairs(node->child);
+    if (subtree != NULL) this->ptr->root = link(this->ptr->root, subtree);
+
+    this->ptr->nodeMap.erase(node->elem);
+    this->ptr->size--;
+    this->ptr->pool.release(node);
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+void BasicPairingHeap<T, Key, Compare, Hash>::erase(const T & elem) {
+    assert(contains(elem));
+
+    erase(this->ptr->nodeMap.find(elem));
+}
+
+template <typename T, typename Key, typename Compare, typename Hash>
+Key BasicPairingHeap<T, Key, Compare, Hash>::key(handle node) {
+    assert(node != NULL);
+
+    return node->key;
+}
+
+#endif
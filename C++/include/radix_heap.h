@@ -0,0 +1,313 @@
+#ifndef RADIX_HEAP_H
+#define RADIX_HEAP_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <vector>
+#include <assert.h>
+
+#include "heap_common.h"
+
+// Radix heap with the same interface as BasicFibonacciHeap, for monotone
+// workloads: every key pushed or decreased to must be at least the key
+// last popped, as in Dijkstra with non-negative weights. Keys are unsigned
+// integers or non-negative floating point values, which order the same
+// way as their bit patterns. An entry sits in the bucket numbered by the
+// highest bit where it differs from the last popped key; when bucket 0
+// runs dry, the next non-empty bucket is redistributed around its
+// minimum, so each entry moves at most once per bit.
+//
+// decreaseKey() adds a fresh entry and leaves the old one behind; stale
+// entries are recognized by their stamp and dropped when their bucket is
+// redistributed. There is no Compare parameter: the order is ascending.
+template <
+    typename T,
+    typename Key = float,
+    typename Hash = std::hash<T>
+>
+class BasicRadixHeap {
+public:
+    // A handle names the element; its live entry is found through the index.
+    struct handle {
+        T elem;
+    };
+
+    BasicRadixHeap();
+    BasicRadixHeap(const BasicRadixHeap &);
+    BasicRadixHeap& operator=(const BasicRadixHeap &);
+    handle push(const T & elem, Key key);
+    T top();
+    void pop();
+    void decreaseKey(const T & elem, Key newKey);
+    void decreaseKey(handle h, Key newKey);
+    void erase(const T & elem);
+    void erase(handle h);
+    Key key(handle h);
+    bool contains(const T & elem);
+    size_t size();
+    bool empty();
+    void reserve(size_t n);
+    void clear();
+    ~BasicRadixHeap();
+
+private:
+    struct Entry;
+    struct Slot;
+    struct ClassVars;
+    ClassVars * ptr;
+
+    void copy(const BasicRadixHeap &);
+    void insertEntry(const T & elem, Key key);
+    bool isLive(const Entry & entry);
+    void settle();
+
+    static uint64_t toBits(Key key);
+    static size_t bucketOf(uint64_t bits, uint64_t last);
+};
+
+template <typename T, typename Key, typename Hash>
+struct BasicRadixHeap<T, Key, Hash>::Entry {
+    uint64_t bits;
+    uint64_t stamp;
+    T elem;
+};
+
+// Per-element state; stamp 0 means absent.
+template <typename T, typename Key, typename Hash>
+struct BasicRadixHeap<T, Key, Hash>::Slot {
+    Key key;
+    uint64_t stamp;
+
+    Slot() : key(), stamp(0) {}
+    Slot(Key key, uint64_t stamp) : key(key), stamp(stamp) {}
+};
+
+const size_t RADIX_BUCKETS = 65;
+
+template <typename T, typename Key, typename Hash>
+struct BasicRadixHeap<T, Key, Hash>::ClassVars {
+    size_t size;
+    uint64_t last;
+    uint64_t nextStamp;
+    std::vector<std::vector<Entry>> buckets;
+    heap_index<T, Slot, Hash> slots;
+};
+
+template <typename T, typename Key, typename Hash>
+BasicRadixHeap<T, Key, Hash>::BasicRadixHeap() {
+    static_assert(
+        std::is_unsigned<Key>::value || std::is_floating_point<Key>::value,
+        "radix heap keys must be unsigned integers or floating point"
+    );
+    static_assert(sizeof(Key) <= sizeof(uint64_t), "radix heap keys must fit in 64 bits");
+
+    this->ptr = new ClassVars;
+    this->ptr->size = 0;
+    this->ptr->last = 0;
+    this->ptr->nextStamp = 1;
+    this->ptr->buckets.resize(RADIX_BUCKETS);
+}
+
+template <typename T, typename Key, typename Hash>
+void BasicRadixHeap<T, Key, Hash>::copy(const BasicRadixHeap & other) {
+    this->ptr = new ClassVars(*other.ptr);
+}
+
+template <typename T, typename Key, typename Hash>
+BasicRadixHeap<T, Key, Hash>::BasicRadixHeap(const BasicRadixHeap & other) {
+    copy(other);
+}
+
+template <typename T, typename Key, typename Hash>
+BasicRadixHeap<T, Key, Hash> & BasicRadixHeap<T, Key, Hash>::operator=(const BasicRadixHeap & other) {
+    if (this == &other) return *this;
+
+    this->~BasicRadixHeap();
+    copy(other);
+    return *this;
+}
+
+template <typename T, typename Key, typename Hash>
+BasicRadixHeap<T, Key, Hash>::~BasicRadixHeap() {
+    delete this->ptr;
+}
+
+template <typename T, typename Key, typename Hash>
+uint64_t BasicRadixHeap<T, Key, Hash>::toBits(Key key) {
+    if constexpr (std::is_floating_point<Key>::value) {
+        assert(key >= 0);
+        if (key == 0) return 0;
+
+        // non-negative IEEE values order like their bit patterns; the
+        // check above folds -0.0 into 0
+        if constexpr (sizeof(Key) == sizeof(uint32_t)) {
+            uint32_t bits;
+            std::memcpy(&bits, &key, sizeof(bits));
+            return bits;
+        } else {
+            uint64_t bits;
+            std::memcpy(&bits, &key, sizeof(bits));
+            return bits;
+        }
+    } else {
+        return static_cast<uint64_t>(key);
+    }
+}
+
+template <typename T, typename Key, typename Hash>
+size_t BasicRadixHeap<T, Key, Hash>::bucketOf(uint64_t bits, uint64_t last) {
+    return bits == last ? 0 : 64 - __builtin_clzll(bits ^ last);
+}
+
+template <typename T, typename Key, typename Hash>
+void BasicRadixHeap<T, Key, Hash>::reserve(size_t n) {
+    this->ptr->slots.reserve(n);
+}
+
+template <typename T, typename Key, typename Hash>
+void BasicRadixHeap<T, Key, Hash>::clear() {
+    this->ptr->size = 0;
+    this->ptr->last = 0;
+    for (std::vector<Entry> & bucket : this->ptr->buckets) {
+        bucket.clear();
+    }
+    this->ptr->slots.clear();
+}
+
+template <typename T, typename Key, typename Hash>
+bool BasicRadixHeap<T, Key, Hash>::contains(const T & elem) {
+    return this->ptr->slots.find(elem).stamp != 0;
+}
+
+template <typename T, typename Key, typename Hash>
+size_t BasicRadixHeap<T, Key, Hash>::size() {
+    return this->ptr->size;
+}
+
+template <typename T, typename Key, typename Hash>
+bool BasicRadixHeap<T, Key, Hash>::empty() {
+    return this->ptr->size == 0;
+}
+
+template <typename T, typename Key, typename Hash>
+bool BasicRadixHeap<T, Key, Hash>::isLive(const Entry & entry) {
+    return this->ptr->slots.find(entry.elem).stamp == entry.stamp;
+}
+
+template <typename T, typename Key, typename Hash>
+void BasicRadixHeap<T, Key, Hash>::insertEntry(const T & elem, Key key) {
+    uint64_t bits = toBits(key);
+    assert(bits >= this->ptr->last);
+
+    uint64_t stamp = this->ptr->nextStamp++;
+    this->ptr->slots.insert(elem, Slot(key, stamp));
+    this->ptr->buckets[bucketOf(bits, this->ptr->last)].push_back(Entry{bits, stamp, elem});
+}
+
+// Leaves a live entry on top of bucket 0.
+template <typename T, typename Key, typename Hash>
+void BasicRadixHeap<T, Key, Hash>::settle() {
+    std::vector<std::vector<Entry>> & buckets = this->ptr->buckets;
+
+    while (true) {
+        while (!buckets[0].empty() && !isLive(buckets[0].back())) {
+            buckets[0].pop_back();
+        }
+        if (!buckets[0].empty()) return;
+
+        size_t i = 1;
+        while (buckets[i].empty()) i++;
+
+        // UINT64_MAX is a valid key, so liveness is tracked separately
+        bool anyLive = false;
+        uint64_t minBits = UINT64_MAX;
+        for (const Entry & entry : buckets[i]) {
+            if (!isLive(entry)) continue;
+            anyLive = true;
+            minBits = std::min(minBits, entry.bits);
+        }
+
+        std::vector<Entry> moving;
+        moving.swap(buckets[i]);
+        if (!anyLive) continue;
+
+        this->ptr->last = minBits;
+        for (const Entry & entry : moving) {
+            if (isLive(entry)) buckets[bucketOf(entry.bits, minBits)].push_back(entry);
+        }
+
+        // hand the storage back so the bucket does not reallocate later
+        moving.clear();
+        if (buckets[i].empty()) buckets[i].swap(moving);
+    }
+}
+
+template <typename T, typename Key, typename Hash>
+typename BasicRadixHeap<T, Key, Hash>::handle
+BasicRadixHeap<T, Key, Hash>::push(const T & elem, Key key) {
+    assert(!contains(elem));
+
+    insertEntry(elem, key);
+    this->ptr->size++;
+
+    return handle{elem};
+}
+
+template <typename T, typename Key, typename Hash>
+T BasicRadixHeap<T, Key, Hash>::top() {
+    assert(!empty());
+
+    settle();
+    return this->ptr->buckets[0].back().elem;
+}
+
+template <typename T, typename Key, typename Hash>
+void BasicRadixHeap<T, Key, Hash>::pop() {
+    assert(!empty());
+
+    settle();
+    this->ptr->slots.erase(this->ptr->buckets[0].back().elem);
+    this->ptr->buckets[0].pop_back();
+    this->ptr->size--;
+}
+
+template <typename T, typename Key, typename Hash>
+void BasicRadixHeap<T, Key, Hash>::decreaseKey(const T & elem, Key newKey) {
+    Slot slot = this->ptr->slots.find(elem);
+    assert(slot.stamp != 0);
+    assert(!(slot.key < newKey));
+
+    if (toBits(newKey) == toBits(slot.key)) return;
+    insertEntry(elem, newKey);
+}
+
+template <typename T, typename Key, typename Hash>
+void BasicRadixHeap<T, Key, Hash>::decreaseKey(handle h, Key newKey) {
+    decreaseKey(h.elem, newKey);
+}
+
+template <typename T, typename Key, typename Hash>
+void BasicRadixHeap<T, Key, Hash>::erase(const T & elem) {
+    assert(contains(elem));
+
+    this->ptr->slots.erase(elem);
+    this->ptr->size--;
+}
+
+template <typename T, typename Key, typename Hash>
+void BasicRadixHeap<T, Key, Hash>::erase(handle h) {
+    erase(h.elem);
+}
+
+template <typename T, typename Key, typename Hash>
+Key BasicRadixHeap<T, Key, Hash>::key(handle h) {
+    Slot slot = this->ptr->slots.find(h.elem);
+    assert(slot.stamp != 0);
+
+    return slot.key;
+}
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <functional>
+#include <string>
+
+class ThreadPool {
+public:
+    ThreadPool(size_t threads = 0);
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool& operator=(const ThreadPool &) = delete;
+    size_t size();
+    void submit(std::function<void()> task);
+    void wait();
+    void parallelFor(size_t n, std::function<void(size_t begin, size_t end, size_t worker)> body);
+    ~ThreadPool();
+
+private:
+    void work();
+    struct ClassVars;
+    ClassVars * ptr;
+};
+
+#endif
@@ -0,0 +1,1056 @@
+#include <functional>
+#include <atomic>
+#include <queue>
+#include <limits>
+#include <cmath>
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+#include <algorithm>
+#include <fstream>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <assert.h>
+
+#include "compact_graph.h"
+#include "thread_pool.h"
+
+typedef std::string vertex;
+typedef uint32_t vertex_id;
+typedef std::vector<vertex> vertex_list;
+typedef std::unordered_set<vertex> vertex_set;
+
+// Binary layout shared by the in-memory image and the file written by
+// save() (native byte order). Every section starts on an 8-byte boundary
+// so a mapped file can be used in place:
+//   file_header
+//   uint64_t nameOffsets[n + 1]    byte offsets into nameData
+//   char     nameData[]            vertex names in sorted order
+//   uint64_t offsets[n + 1]        CSR rows
+//   uint32_t targets[m]
+//   float    weights[m]            weighted graphs only
+//   uint64_t inOffsets[n + 1]      directed graphs only
+//   uint32_t inSources[m]          directed graphs only
+const uint32_t COMPACT_GRAPH_MAGIC = 0x46524743;
+const uint32_t COMPACT_GRAPH_VERSION = 1;
+
+struct file_header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t directed;
+    uint32_t weighted;
+    uint64_t numVertices;
+    uint64_t numEdges;
+    uint64_t nameBytes;
+};
+
+size_t align8(size_t bytes) {
+    return (bytes + 7) & ~(size_t) 7;
+}
+
+size_t imageSize(const file_header & header) {
+    size_t n = header.numVertices;
+    size_t m = header.numEdges;
+
+    size_t size = sizeof(file_header);
+    size += align8((n + 1) * sizeof(uint64_t)) + align8(header.nameBytes);
+    size += align8((n + 1) * sizeof(uint64_t)) + align8(m * sizeof(vertex_id));
+    if (header.weighted) size += align8(m * sizeof(float));
+    if (header.directed) size += align8((n + 1) * sizeof(uint64_t)) + align8(m * sizeof(vertex_id));
+
+    return size;
+}
+
+void appendSection(std::vector<uint64_t> & image, const void * data, size_t bytes) {
+    size_t start = image.size();
+    image.resize(start + align8(bytes) / sizeof(uint64_t), 0);
+    if (bytes > 0) memcpy(image.data() + start, data, bytes);
+}
+
+// Names stored back to back in sorted order; indexing copies one out.
+struct string_table {
+    const uint64_t * offsets;
+    const char * data;
+    size_t count;
+
+    size_t size() const {
+        return count;
+    }
+
+    std::string_view view(size_t i) const {
+        return std::string_view(data + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+
+    vertex operator[](size_t i) const {
+        return vertex(view(i));
+    }
+};
+
+struct CompactGraph::ClassVars {
+    bool directed;
+    bool weighted;
+    size_t numEdges;
+    string_table names;
+    const uint64_t * offsets;
+    const vertex_id * targets;
+    const float * weights;
+    const uint64_t * inOffsets;
+    const vertex_id * inSources;
+
+    // the image lives either in 'storage' or in a read-only file mapping
+    const char * base;
+    size_t size;
+    std::vector<uint64_t> storage;
+    void * mapping;
+    size_t mappingSize;
+
+    // points every array at its section of the image starting at 'image'
+    void bind(const char * image) {
+        file_header header;
+        memcpy(&header, image, sizeof(header));
+        assert(header.magic == COMPACT_GRAPH_MAGIC);
+        assert(header.version == COMPACT_GRAPH_VERSION);
+
+        size_t n = header.numVertices;
+        size_t m = header.numEdges;
+        directed = header.directed;
+        weighted = header.weighted;
+        numEdges = m;
+        base = image;
+        size = imageSize(header);
+
+        const char * cursor = image + sizeof(file_header);
+        names.count = n;
+        names.offsets = (const uint64_t *) cursor;
+        cursor += align8((n + 1) * sizeof(uint64_t));
+        names.data = cursor;
+        cursor += align8(header.nameBytes);
+
+        offsets = (const uint64_t *) cursor;
+        cursor += align8((n + 1) * sizeof(uint64_t));
+        targets = (const vertex_id *) cursor;
+        cursor += align8(m * sizeof(vertex_id));
+
+        weights = NULL;
+        if (weighted) {
+            weights = (const float *) cursor;
+            cursor += align8(m * sizeof(float));
+        }
+
+        inOffsets = NULL;
+        inSources = NULL;
+        if (directed) {
+            inOffsets = (const uint64_t *) cursor;
+            cursor += align8((n + 1) * sizeof(uint64_t));
+            inSources = (const vertex_id *) cursor;
+        }
+    }
+
+    // Returns why the bound sections cannot be walked safely, or NULL if
+    // they can: both offset arrays must start at 0, never decrease and end
+    // at their section's length, and every endpoint must be a vertex.
+    const char * contentError(size_t nameBytes) const {
+        size_t n = names.count;
+        if (!isRange(names.offsets, n, nameBytes)) return "corrupt name offsets";
+        if (!isRange(offsets, n, numEdges)) return "corrupt edge offsets";
+        if (!areVertices(targets, numEdges, n)) return "edge target out of range";
+        if (directed) {
+            if (!isRange(inOffsets, n, numEdges)) return "corrupt incoming edge offsets";
+            if (!areVertices(inSources, numEdges, n)) return "edge source out of range";
+        }
+
+        return NULL;
+    }
+
+    static bool isRange(const uint64_t * offsets, size_t n, uint64_t total) {
+        if (offsets[0] != 0 || offsets[n] != total) return false;
+        for (size_t i = 0; i < n; i++) {
+            if (offsets[i] > offsets[i + 1]) return false;
+        }
+
+        return true;
+    }
+
+    static bool areVertices(const vertex_id * ids, size_t m, size_t n) {
+        for (size_t e = 0; e < m; e++) {
+            if (ids[e] >= n) return false;
+        }
+
+        return true;
+    }
+
+    // takes a private copy of another graph's image
+    void copy(const ClassVars & other) {
+        storage.assign(other.size / sizeof(uint64_t), 0);
+        memcpy(storage.data(), other.base, other.size);
+        mapping = NULL;
+        bind((const char *) storage.data());
+    }
+};
+
+CompactGraph::CompactGraph(const Graph & g) {
+    bool directed = g.isDirected();
+    bool weighted = g.isWeighted();
+
+    vertex_set vertices = g.getVertices();
+    vertex_list names(vertices.begin(), vertices.end());
+    std::sort(names.begin(), names.end());
+    size_t n = names.size();
+
+    std::vector<uint64_t> nameOffsets(1, 0);
+    std::string nameData;
+    for (const vertex & v : names) {
+        nameData += v;
+        nameOffsets.push_back(nameData.size());
+    }
+
+    std::vector<vertex_id> toCompactId;
+    for (size_t i = 0; i < n; i++) {
+        vertex_id id = g.getId(names[i]);
+        if (id >= toCompactId.size()) toCompactId.resize(id + 1);
+
+        toCompactId[id] = i;
+    }
+
+    std::vector<std::pair<vertex_id, float>> row;
+    std::vector<uint64_t> offsets(n + 1, 0);
+    std::vector<vertex_id> targets;
+    std::vector<float> weights;
+    for (size_t i = 0; i < n; i++) {
+        row.clear();
+        for (Graph::Neighbor neighbor : g.neighbors(names[i])) {
+            row.push_back({toCompactId[neighbor.id], neighbor.edgeValue});
+        }
+
+        std::sort(row.begin(), row.end());
+        for (std::pair<vertex_id, float> entry : row) {
+            targets.push_back(entry.first);
+            if (weighted) weights.push_back(entry.second);
+        }
+
+        offsets[i + 1] = targets.size();
+    }
+
+    std::vector<uint64_t> inOffsets;
+    std::vector<vertex_id> inSources;
+    if (directed) {
+        inOffsets.resize(n + 1, 0);
+        for (vertex_id target : targets) {
+            inOffsets[target + 1]++;
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            inOffsets[i + 1] += inOffsets[i];
+        }
+
+        std::vector<uint64_t> cursor(inOffsets.begin(), inOffsets.end() - 1);
+        inSources.resize(targets.size());
+        for (size_t u = 0; u < n; u++) {
+            for (uint64_t e = offsets[u]; e < offsets[u + 1]; e++) {
+                inSources[cursor[targets[e]]++] = u;
+            }
+        }
+    }
+
+    file_header header = {
+        COMPACT_GRAPH_MAGIC, COMPACT_GRAPH_VERSION, directed, weighted,
+        n, targets.size(), nameData.size()
+    };
+
+    this->ptr = new ClassVars;
+    std::vector<uint64_t> & image = this->ptr->storage;
+    image.reserve(imageSize(header) / sizeof(uint64_t));
+
+    appendSection(image, &header, sizeof(header));
+    appendSection(image, nameOffsets.data(), nameOffsets.size() * sizeof(uint64_t));
+    appendSection(image, nameData.data(), nameData.size());
+    appendSection(image, offsets.data(), offsets.size() * sizeof(uint64_t));
+    appendSection(image, targets.data(), targets.size() * sizeof(vertex_id));
+    if (weighted) appendSection(image, weights.data(), weights.size() * sizeof(float));
+    if (directed) {
+        appendSection(image, inOffsets.data(), inOffsets.size() * sizeof(uint64_t));
+        appendSection(image, inSources.data(), inSources.size() * sizeof(vertex_id));
+    }
+
+    this->ptr->mapping = NULL;
+    this->ptr->bind((const char *) image.data());
+}
+
+CompactGraph::CompactGraph(ClassVars * vars) {
+    this->ptr = vars;
+}
+
+CompactGraph::CompactGraph(const CompactGraph & other) {
+    this->ptr = new ClassVars;
+    this->ptr->copy(*other.ptr);
+}
+
+CompactGraph & CompactGraph::operator=(const CompactGraph & other) {
+    if (this == &other) return *this;
+
+    this->~CompactGraph();
+
+    this->ptr = new ClassVars;
+    this->ptr->copy(*other.ptr);
+    return *this;
+}
+
+CompactGraph::~CompactGraph() {
+    if (this->ptr->mapping != NULL) munmap(this->ptr->mapping, this->ptr->mappingSize);
+    delete this->ptr;
+}
+
+void CompactGraph::save(std::string path) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("CompactGraph::save: cannot open " + path);
+
+    out.write(this->ptr->base, this->ptr->size);
+    out.close();
+    if (!out) throw std::runtime_error("CompactGraph::save: cannot write " + path);
+}
+
+// Returns why the header cannot describe an image of 'fileSize' bytes,
+// or NULL if it can. The counts are bounded by the file size before
+// imageSize() multiplies them, so the sum cannot overflow.
+const char * headerError(const file_header & header, size_t fileSize) {
+    if (header.magic != COMPACT_GRAPH_MAGIC) return "not a compact graph file";
+    if (header.version != COMPACT_GRAPH_VERSION) return "unsupported compact graph version";
+    if (header.directed > 1 || header.weighted > 1) return "corrupt header flags";
+    if (header.numVertices >= std::numeric_limits<vertex_id>::max()) return "too many vertices";
+    if (header.numVertices > fileSize / sizeof(uint64_t) || header.numEdges > fileSize / sizeof(vertex_id) ||
+        header.nameBytes > fileSize) return "truncated file";
+    if (imageSize(header) > fileSize) return "truncated file";
+
+    return NULL;
+}
+
+CompactGraph CompactGraph::load(std::string path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("CompactGraph::load: cannot open " + path + ": " + strerror(errno));
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        int error = errno;
+        close(fd);
+        throw std::runtime_error("CompactGraph::load: cannot stat " + path + ": " + strerror(error));
+    }
+
+    size_t fileSize = st.st_size;
+    if (fileSize < sizeof(file_header)) {
+        close(fd);
+        throw std::runtime_error("CompactGraph::load: " + path + ": truncated file");
+    }
+
+    void * mapping = mmap(NULL, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+    int error = errno;
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("CompactGraph::load: cannot map " + path + ": " + strerror(error));
+    }
+
+    file_header header;
+    memcpy(&header, mapping, sizeof(header));
+    const char * problem = headerError(header, fileSize);
+    if (problem != NULL) {
+        munmap(mapping, fileSize);
+        throw std::runtime_error("CompactGraph::load: " + path + ": " + problem);
+    }
+
+    ClassVars * vars = new ClassVars;
+    vars->mapping = mapping;
+    vars->mappingSize = fileSize;
+    vars->bind((const char *) mapping);
+
+    problem = vars->contentError(header.nameBytes);
+    if (problem != NULL) {
+        munmap(mapping, fileSize);
+        delete vars;
+        throw std::runtime_error("CompactGraph::load: " + path + ": " + problem);
+    }
+
+    return CompactGraph(vars);
+}
+
+bool CompactGraph::empty() {
+    return numVertices() == 0;
+}
+
+size_t CompactGraph::numVertices() {
+    return this->ptr->names.size();
+}
+
+size_t CompactGraph::numEdges() {
+    return this->ptr->numEdges;
+}
+
+// Position of 'v' in the sorted name table, or the vertex count if absent.
+size_t findName(const string_table & names, const vertex & v) {
+    size_t lo = 0;
+    size_t hi = names.size();
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (names.view(mid) < v) lo = mid + 1;
+        else hi = mid;
+    }
+
+    return lo < names.size() && names.view(lo) == v ? lo : names.size();
+}
+
+bool CompactGraph::hasVertex(vertex v) {
+    return findName(this->ptr->names, v) != numVertices();
+}
+
+vertex_id CompactGraph::getId(vertex v) {
+    assert(hasVertex(v));
+    return findName(this->ptr->names, v);
+}
+
+vertex CompactGraph::getVertex(vertex_id id) {
+    assert(id < numVertices());
+    return this->ptr->names[id];
+}
+
+vertex_list CompactGraph::dfs(vertex v) {
+    assert(hasVertex(v));
+
+    const uint64_t * offsets = this->ptr->offsets;
+    const vertex_id * targets = this->ptr->targets;
+
+    vertex_list traversalList;
+    std::vector<vertex_id> stk;
+    std::vector<bool> visited(numVertices(), false);
+    stk.push_back(getId(v));
+
+    while (!stk.empty()) {
+        vertex_id u = stk.back();
+        stk.pop_back();
+
+        if (visited[u]) continue;
+
+        visited[u] = true;
+        traversalList.push_back(this->ptr->names[u]);
+
+        for (uint64_t e = offsets[u]; e < offsets[u + 1]; e++) {
+            if (visited[targets[e]]) continue;
+
+            stk.push_back(targets[e]);
+        }
+    }
+
+    return traversalList;
+}
+
+vertex_list CompactGraph::bfs(vertex v) {
+    assert(hasVertex(v));
+
+    const uint64_t * offsets = this->ptr->offsets;
+    const vertex_id * targets = this->ptr->targets;
+
+    vertex_list traversalList;
+    std::vector<vertex_id> q;
+    std::vector<bool> visited(numVertices(), false);
+
+    vertex_id s = getId(v);
+    q.push_back(s);
+    visited[s] = true;
+
+    for (size_t head = 0; head < q.size(); head++) {
+        vertex_id u = q[head];
+        traversalList.push_back(this->ptr->names[u]);
+
+        for (uint64_t e = offsets[u]; e < offsets[u + 1]; e++) {
+            if (visited[targets[e]]) continue;
+
+            visited[targets[e]] = true;
+            q.push_back(targets[e]);
+        }
+    }
+
+    return traversalList;
+}
+
+// Direction-optimizing BFS (Beamer et al.): expand the frontier top-down
+// while it is small, and switch to scanning unvisited vertices for a
+// parent in the frontier once the frontier's edges outnumber a fraction
+// of the unexplored edges.
+const uint64_t BFS_TOP_DOWN_ALPHA = 14;
+const uint64_t BFS_BOTTOM_UP_BETA = 24;
+
+std::pair<vertex_list, std::vector<int>> CompactGraph::parallelBfs(vertex v, size_t threads) {
+    assert(hasVertex(v));
+
+    const uint64_t * offsets = this->ptr->offsets;
+    const vertex_id * targets = this->ptr->targets;
+    const uint64_t * inOffsets = this->ptr->directed ? this->ptr->inOffsets : offsets;
+    const vertex_id * inSources = this->ptr->directed ? this->ptr->inSources : targets;
+
+    size_t n = numVertices();
+    size_t words = (n + 63) / 64;
+    ThreadPool pool(threads);
+
+    std::vector<int> depth(n, -1);
+    std::vector<std::atomic<uint64_t>> visited(words);
+    std::vector<uint64_t> frontierBits(words, 0);
+    for (std::atomic<uint64_t> & word : visited) {
+        word.store(0);
+    }
+
+    vertex_id s = getId(v);
+    depth[s] = 0;
+    visited[s / 64].fetch_or(1ull << (s % 64));
+
+    std::vector<vertex_id> frontier = {s};
+    std::vector<vertex_id> order = {s};
+    std::vector<std::vector<vertex_id>> nextFrontiers(pool.size());
+    uint64_t unexploredEdges = numEdges() - (offsets[s + 1] - offsets[s]);
+    bool bottomUp = false;
+
+    for (int level = 0; !frontier.empty(); level++) {
+        uint64_t frontierEdges = 0;
+        for (vertex_id u : frontier) {
+            frontierEdges += offsets[u + 1] - offsets[u];
+        }
+
+        if (!bottomUp && frontierEdges > unexploredEdges / BFS_TOP_DOWN_ALPHA) {
+            bottomUp = true;
+        } else if (bottomUp && frontier.size() < n / BFS_BOTTOM_UP_BETA) {
+            bottomUp = false;
+        }
+
+        for (std::vector<vertex_id> & next : nextFrontiers) {
+            next.clear();
+        }
+
+        if (!bottomUp) {
+            pool.parallelFor(frontier.size(), [&](size_t begin, size_t end, size_t worker) {
+                for (size_t i = begin; i < end; i++) {
+                    vertex_id u = frontier[i];
+
+                    for (uint64_t e = offsets[u]; e < offsets[u + 1]; e++) {
+                        vertex_id w = targets[e];
+                        uint64_t mask = 1ull << (w % 64);
+
+                        if (visited[w / 64].load(std::memory_order_relaxed) & mask) continue;
+                        if (visited[w / 64].fetch_or(mask) & mask) continue;
+
+                        depth[w] = level + 1;
+                        nextFrontiers[worker].push_back(w);
+                    }
+                }
+            });
+        } else {
+            std::fill(frontierBits.begin(), frontierBits.end(), 0);
+            for (vertex_id u : frontier) {
+                frontierBits[u / 64] |= 1ull << (u % 64);
+            }
+
+            pool.parallelFor(n, [&](size_t begin, size_t end, size_t worker) {
+                for (vertex_id w = begin; w < end; w++) {
+                    uint64_t mask = 1ull << (w % 64);
+                    if (visited[w / 64].load(std::memory_order_relaxed) & mask) continue;
+
+                    for (uint64_t e = inOffsets[w]; e < inOffsets[w + 1]; e++) {
+                        vertex_id u = inSources[e];
+                        if (!(frontierBits[u / 64] & (1ull << (u % 64)))) continue;
+
+                        visited[w / 64].fetch_or(mask);
+                        depth[w] = level + 1;
+                        nextFrontiers[worker].push_back(w);
+                        break;
+                    }
+                }
+            });
+        }
+
+        frontier.clear();
+        for (const std::vector<vertex_id> & next : nextFrontiers) {
+            frontier.insert(frontier.end(), next.begin(), next.end());
+        }
+
+        std::sort(frontier.begin(), frontier.end());
+        for (vertex_id u : frontier) {
+            unexploredEdges -= offsets[u + 1] - offsets[u];
+        }
+
+        order.insert(order.end(), frontier.begin(), frontier.end());
+    }
+
+    vertex_list traversalList;
+    traversalList.reserve(order.size());
+    for (vertex_id u : order) {
+        traversalList.push_back(this->ptr->names[u]);
+    }
+
+    return std::pair<vertex_list, std::vector<int>>(traversalList, depth);
+}
+
+std::pair<
+    std::unordered_map<vertex, float>,
+    std::unordered_map<vertex, vertex>
+>
+distancesToMaps(
+    const string_table & names,
+    const std::vector<float> & dist,
+    const std::vector<vertex_id> & prev
+) {
+    std::unordered_map<vertex, float> distMap;
+    std::unordered_map<vertex, vertex> prevMap;
+    size_t n = names.size();
+
+    for (size_t u = 0; u < n; u++) {
+        distMap[names[u]] = dist[u];
+        if (prev[u] == n) continue;
+
+        prevMap[names[u]] = names[prev[u]];
+    }
+
+    return std::pair<
+        std::unordered_map<vertex, float>,
+        std::unordered_map<vertex, vertex>
+    >(distMap, prevMap);
+}
+
+std::pair<
+    std::unordered_map<vertex, float>,
+    std::unordered_map<vertex, vertex>
+>
+CompactGraph::dijkstra(vertex v) {
+    assert(hasVertex(v));
+    assert(this->ptr->weighted);
+
+    const uint64_t * offsets = this->ptr->offsets;
+    const vertex_id * targets = this->ptr->targets;
+    const float * weights = this->ptr->weights;
+
+    size_t n = numVertices();
+    float inf = std::numeric_limits<float>::max();
+    std::vector<float> dist(n, inf);
+    std::vector<vertex_id> prev(n, n);
+    std::vector<bool> settled(n, false);
+
+    typedef std::pair<float, vertex_id> entry;
+    std::priority_queue<entry, std::vector<entry>, std::greater<entry>> pq;
+
+    vertex_id s = getId(v);
+    dist[s] = 0;
+    pq.push(entry(0, s));
+
+    while (!pq.empty()) {
+        vertex_id u = pq.top().second;
+        pq.pop();
+
+        if (settled[u]) continue;
+        settled[u] = true;
+
+        for (uint64_t e = offsets[u]; e < offsets[u + 1]; e++) {
+            vertex_id neighbor = targets[e];
+            if (settled[neighbor]) continue;
+
+            float alt = dist[u] + weights[e];
+            if (alt >= dist[neighbor]) continue;
+
+            dist[neighbor] = alt;
+            prev[neighbor] = u;
+            pq.push(entry(alt, neighbor));
+        }
+    }
+
+    return distancesToMaps(this->ptr->names, dist, prev);
+}
+
+// Delta-stepping keeps each tentative distance and its predecessor in
+// one 64-bit word (distance bits high, predecessor low) so a relaxation
+// updates both with a single compare-and-swap. Non-negative floats
+// order the same way as their bit patterns.
+uint64_t packDistance(float dist, vertex_id prev) {
+    uint32_t bits;
+    memcpy(&bits, &dist, sizeof(bits));
+    return ((uint64_t) bits << 32) | prev;
+}
+
+float unpackDistance(uint64_t state) {
+    uint32_t bits = state >> 32;
+    float dist;
+    memcpy(&dist, &bits, sizeof(dist));
+    return dist;
+}
+
+bool relaxPacked(std::atomic<uint64_t> & state, float dist, vertex_id prev) {
+    uint64_t desired = packDistance(dist, prev);
+    uint64_t current = state.load(std::memory_order_relaxed);
+
+    while (unpackDistance(current) > dist) {
+        if (state.compare_exchange_weak(current, desired)) return true;
+    }
+
+    return false;
+}
+
+// While bucket i is processed every queued distance is below
+// (i + 1) * delta + maxWeight, so only ceil(maxWeight / delta) + 1
+// buckets are ever live and bucket i is kept in slot i modulo that count.
+const size_t DELTA_STEPPING_MAX_BUCKETS = 1 << 20;
+
+std::pair<
+    std::unordered_map<vertex, float>,
+    std::unordered_map<vertex, vertex>
+>
+CompactGraph::deltaStepping(vertex v, float delta, size_t threads) {
+    assert(hasVertex(v));
+    assert(this->ptr->weighted);
+    assert(delta > 0);
+
+    const uint64_t * offsets = this->ptr->offsets;
+    const vertex_id * targets = this->ptr->targets;
+    const float * weights = this->ptr->weights;
+
+    size_t n = numVertices();
+    float inf = std::numeric_limits<float>::max();
+    ThreadPool pool(threads);
+
+    std::vector<std::atomic<uint64_t>> state(n);
+    for (std::atomic<uint64_t> & s : state) {
+        s.store(packDistance(inf, n));
+    }
+
+    vertex_id s = getId(v);
+    state[s].store(packDistance(0, n));
+
+    float maxWeight = 0;
+    for (uint64_t e = 0; e < offsets[n]; e++) {
+        maxWeight = std::max(maxWeight, weights[e]);
+    }
+    assert(maxWeight / delta < DELTA_STEPPING_MAX_BUCKETS);
+
+    size_t numBuckets = (size_t) std::ceil(maxWeight / delta) + 1;
+    std::vector<std::vector<vertex_id>> buckets(numBuckets);
+    buckets[0].push_back(s);
+    size_t queued = 1;
+
+    std::vector<std::vector<vertex_id>> requests(pool.size());
+    std::vector<vertex_id> current;
+    std::vector<vertex_id> settled;
+
+    // relaxes either the light (weight <= delta) or heavy edges out of
+    // every vertex in 'sources' and files improved vertices into buckets
+    auto relaxEdges = [&](const std::vector<vertex_id> & sources, bool light) {
+        pool.parallelFor(sources.size(), [&](size_t begin, size_t end, size_t worker) {
+            for (size_t i = begin; i < end; i++) {
+                vertex_id u = sources[i];
+                float du = unpackDistance(state[u].load(std::memory_order_relaxed));
+
+                for (uint64_t e = offsets[u]; e < offsets[u + 1]; e++) {
+                    assert(weights[e] >= 0);
+                    if ((weights[e] <= delta) != light) continue;
+
+                    if (relaxPacked(state[targets[e]], du + weights[e], u))
+                        requests[worker].push_back(targets[e]);
+                }
+            }
+        });
+
+        for (std::vector<vertex_id> & request : requests) {
+            for (vertex_id w : request) {
+                size_t bucket = unpackDistance(state[w].load()) / delta;
+                buckets[bucket % numBuckets].push_back(w);
+            }
+
+            queued += request.size();
+
+            request.clear();
+        }
+    };
+
+    for (size_t i = 0; queued > 0; i++) {
+        std::vector<vertex_id> & bucket = buckets[i % numBuckets];
+        if (bucket.empty()) continue;
+
+        settled.clear();
+
+        while (!bucket.empty()) {
+            current.swap(bucket);
+            bucket.clear();
+            queued -= current.size();
+
+            std::sort(current.begin(), current.end());
+            current.erase(std::unique(current.begin(), current.end()), current.end());
+
+            size_t kept = 0;
+            for (vertex_id u : current) {
+                if ((size_t) (unpackDistance(state[u].load()) / delta) != i) continue;
+
+                current[kept++] = u;
+            }
+
+            current.resize(kept);
+            settled.insert(settled.end(), current.begin(), current.end());
+            relaxEdges(current, true);
+        }
+
+        std::sort(settled.begin(), settled.end());
+        settled.erase(std::unique(settled.begin(), settled.end()), settled.end());
+        relaxEdges(settled, false);
+    }
+
+    std::vector<float> dist(n);
+    std::vector<vertex_id> prev(n);
+    for (size_t u = 0; u < n; u++) {
+        uint64_t packed = state[u].load();
+        dist[u] = unpackDistance(packed);
+        prev[u] = packed & 0xffffffff;
+    }
+
+    return distancesToMaps(this->ptr->names, dist, prev);
+}
+
+// Each pass relaxes the whole CSR edge array. With more than one thread
+// the array is cut into equal edge ranges and distances are lowered with
+// the same packed compare-and-swap as deltaStepping, so a pass may
+// already see improvements made earlier in the same pass. Passes stop
+// once one changes nothing.
+std::pair<
+    std::unordered_map<vertex, float>,
+    std::unordered_map<vertex, vertex>
+>
+CompactGraph::bellmanFord(vertex v, size_t threads) {
+    assert(hasVertex(v));
+    assert(this->ptr->weighted);
+
+    const uint64_t * offsets = this->ptr->offsets;
+    const vertex_id * targets = this->ptr->targets;
+    const float * weights = this->ptr->weights;
+
+    size_t n = numVertices();
+    size_t m = numEdges();
+    float inf = std::numeric_limits<float>::max();
+
+    if (threads == 1) {
+        std::vector<float> dist(n, inf);
+        std::vector<vertex_id> prev(n, n);
+        dist[getId(v)] = 0;
+
+        bool changed = true;
+        for (size_t it = 0; changed && it + 1 < n; it++) {
+            changed = false;
+
+            for (vertex_id u = 0; u < n; u++) {
+                if (dist[u] == inf) continue;
+
+                for (uint64_t e = offsets[u]; e < offsets[u + 1]; e++) {
+                    float alt = dist[u] + weights[e];
+                    if (alt >= dist[targets[e]]) continue;
+
+                    dist[targets[e]] = alt;
+                    prev[targets[e]] = u;
+                    changed = true;
+                }
+            }
+        }
+
+        return distancesToMaps(this->ptr->names, dist, prev);
+    }
+
+    ThreadPool pool(threads);
+    std::vector<std::atomic<uint64_t>> state(n);
+    for (std::atomic<uint64_t> & s : state) {
+        s.store(packDistance(inf, n));
+    }
+    state[getId(v)].store(packDistance(0, n));
+
+    size_t parts = pool.size();
+    std::atomic<bool> changed(true);
+    for (size_t it = 0; changed.load() && it + 1 < n; it++) {
+        changed.store(false);
+
+        pool.parallelFor(parts, [&](size_t begin, size_t end, size_t) {
+            for (size_t part = begin; part < end; part++) {
+                uint64_t first = m * part / parts;
+                uint64_t last = m * (part + 1) / parts;
+                if (first == last) continue;
+
+                vertex_id u = std::upper_bound(offsets, offsets + n + 1, first) - offsets - 1;
+                bool improved = false;
+
+                for (uint64_t e = first; e < last; e++) {
+                    while (offsets[u + 1] <= e) u++;
+
+                    float du = unpackDistance(state[u].load(std::memory_order_relaxed));
+                    if (du == inf) continue;
+
+                    if (relaxPacked(state[targets[e]], du + weights[e], u)) improved = true;
+                }
+
+                if (improved) changed.store(true);
+            }
+        });
+    }
+
+    std::vector<float> dist(n);
+    std::vector<vertex_id> prev(n);
+    for (vertex_id u = 0; u < n; u++) {
+        uint64_t s = state[u].load();
+        dist[u] = unpackDistance(s);
+        prev[u] = (vertex_id) s;
+    }
+
+    return distancesToMaps(this->ptr->names, dist, prev);
+}
+
+std::vector<std::pair<vertex, vertex>> CompactGraph::mst() {
+    assert(this->ptr->weighted);
+
+    const uint64_t * offsets = this->ptr->offsets;
+    const vertex_id * targets = this->ptr->targets;
+    const float * weights = this->ptr->weights;
+    const string_table & names = this->ptr->names;
+
+    size_t n = numVertices();
+    float inf = std::numeric_limits<float>::max();
+    std::vector<float> cost(n, inf);
+    std::vector<vertex_id> prev(n, n);
+    std::vector<bool> inTree(n, false);
+    std::vector<std::pair<vertex, vertex>> tree;
+
+    typedef std::pair<float, vertex_id> entry;
+    std::priority_queue<entry, std::vector<entry>, std::greater<entry>> pq;
+
+    for (vertex_id root = 0; root < n; root++) {
+        if (inTree[root]) continue;
+
+        cost[root] = 0;
+        pq.push(entry(0, root));
+
+        while (!pq.empty()) {
+            vertex_id u = pq.top().second;
+            pq.pop();
+
+            if (inTree[u]) continue;
+            inTree[u] = true;
+
+            if (prev[u] != n) {
+                vertex_id p = prev[u];
+                tree.push_back(names[p] < names[u] ? std::pair<vertex, vertex>(names[p], names[u]) : std::pair<vertex, vertex>(names[u], names[p]));
+            }
+
+            for (uint64_t e = offsets[u]; e < offsets[u + 1]; e++) {
+                vertex_id v = targets[e];
+                if (inTree[v] || cost[v] <= weights[e]) continue;
+
+                cost[v] = weights[e];
+                prev[v] = u;
+                pq.push(entry(cost[v], v));
+            }
+        }
+    }
+
+    return tree;
+}
+
+vertex_list CompactGraph::topologicalSort() {
+    assert(this->ptr->directed);
+
+    const uint64_t * offsets = this->ptr->offsets;
+    const vertex_id * targets = this->ptr->targets;
+
+    size_t n = numVertices();
+    std::vector<size_t> inDegree(n, 0);
+    for (uint64_t e = 0; e < numEdges(); e++) {
+        inDegree[targets[e]]++;
+    }
+
+    std::vector<vertex_id> stk;
+    for (vertex_id v = 0; v < n; v++) {
+        if (inDegree[v] != 0) continue;
+
+        stk.push_back(v);
+    }
+
+    vertex_list tps;
+    while (!stk.empty()) {
+        vertex_id u = stk.back();
+        stk.pop_back();
+        tps.push_back(this->ptr->names[u]);
+
+        for (uint64_t e = offsets[u]; e < offsets[u + 1]; e++) {
+            if (--inDegree[targets[e]] != 0) continue;
+
+            stk.push_back(targets[e]);
+        }
+    }
+
+    if (tps.size() != n) return {};
+
+    return tps;
+}
+
+std::vector<vertex_set> CompactGraph::stronglyConnectedComponents() {
+    assert(this->ptr->directed);
+
+    const uint64_t * offsets = this->ptr->offsets;
+    const vertex_id * targets = this->ptr->targets;
+
+    size_t n = numVertices();
+    size_t unvisited = std::numeric_limits<size_t>::max();
+    std::vector<size_t> index(n, unvisited);
+    std::vector<size_t> low(n, 0);
+    std::vector<bool> onStack(n, false);
+    std::vector<vertex_id> stk;
+    std::vector<std::pair<vertex_id, uint64_t>> callStack;
+    std::vector<vertex_set> components;
+    size_t counter = 0;
+
+    for (vertex_id s = 0; s < n; s++) {
+        if (index[s] != unvisited) continue;
+
+        index[s] = low[s] = counter++;
+        stk.push_back(s);
+        onStack[s] = true;
+        callStack.push_back({s, offsets[s]});
+
+        while (!callStack.empty()) {
+            vertex_id u = callStack.back().first;
+            uint64_t e = callStack.back().second;
+
+            if (e < offsets[u + 1]) {
+                callStack.back().second++;
+                vertex_id w = targets[e];
+
+                if (index[w] == unvisited) {
+                    index[w] = low[w] = counter++;
+                    stk.push_back(w);
+                    onStack[w] = true;
+                    callStack.push_back({w, offsets[w]});
+                } else if (onStack[w]) {
+                    low[u] = std::min(low[u], index[w]);
+                }
+
+                continue;
+            }
+
+            callStack.pop_back();
+            if (!callStack.empty()) {
+                vertex_id parent = callStack.back().first;
+                low[parent] = std::min(low[parent], low[u]);
+            }
+
+            if (low[u] != index[u]) continue;
+
+            vertex_set component;
+            vertex_id w;
+            do {
+                w = stk.back();
+                stk.pop_back();
+                onStack[w] = false;
+                component.insert(this->ptr->names[w]);
+            } while (w != u);
+
+            components.push_back(component);
+        }
+    }
+
+    return components;
+}
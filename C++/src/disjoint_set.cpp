@@ -21,6 +21,8 @@ DisjointSetNode * createNewNode(std::string & elem) {
 struct DisjointSet::ClassVars {
     size_t size;
     std::unordered_map<std::string, DisjointSetNode *> nodeMap;
+    std::vector<size_t> parents;
+    std::vector<size_t> ranks;
 };
 
 DisjointSet::DisjointSet() {
@@ -37,9 +39,21 @@ DisjointSet::DisjointSet(std::vector<std::string> & vec) {
     }
 }
 
+DisjointSet::DisjointSet(size_t n) {
+    this->ptr = new ClassVars;
+    this->ptr->size = n;
+    this->ptr->ranks.assign(n, 0);
+
+    for (size_t x = 0; x < n; x++) {
+        this->ptr->parents.push_back(x);
+    }
+}
+
 void DisjointSet::copy(const DisjointSet & other) {
     this->ptr = new ClassVars;
-    this->ptr->size = 0;
+    this->ptr->size = other.ptr->parents.size();
+    this->ptr->parents = other.ptr->parents;
+    this->ptr->ranks = other.ptr->ranks;
     
     for (std::pair<std::string, DisjointSetNode *> kvPair : other.ptr->nodeMap) {
         std::string elem = kvPair.first;
@@ -80,6 +94,10 @@ bool DisjointSet::contains(std::string x) {
     return this->ptr->nodeMap.find(x) != this->ptr->nodeMap.end();
 }
 
+bool DisjointSet::contains(size_t x) {
+    return x < this->ptr->parents.size();
+}
+
 void DisjointSet::insert(std::string x) {
     if (contains(x)) return;
 
@@ -106,6 +124,18 @@ std::string DisjointSet::find(std::string x) {
     return curr->parent->elem;
 }
 
+size_t DisjointSet::find(size_t x) {
+    assert(contains(x));
+
+    std::vector<size_t> & parents = this->ptr->parents;
+    while (parents[x] != x) {
+        parents[x] = parents[parents[x]];
+        x = parents[x];
+    }
+
+    return x;
+}
+
 void DisjointSet::setUnion(std::string x, std::string y) {
     if (!contains(x) || !contains(y)) return;
 
@@ -122,6 +152,24 @@ void DisjointSet::setUnion(std::string x, std::string y) {
     }
 }
 
+void DisjointSet::setUnion(size_t x, size_t y) {
+    if (!contains(x) || !contains(y)) return;
+
+    size_t u = find(x);
+    size_t v = find(y);
+    if (u == v) return;
+
+    std::vector<size_t> & ranks = this->ptr->ranks;
+    if (ranks[u] == ranks[v]) {
+        ranks[u]++;
+        this->ptr->parents[v] = u;
+    } else if (ranks[u] > ranks[v]) {
+        this->ptr->parents[v] = u;
+    } else {
+        this->ptr->parents[u] = v;
+    }
+}
+
 DisjointSet::~DisjointSet() {
     for (std::pair<std::string, DisjointSetNode *> kvPair : this->ptr->nodeMap) {
         DisjointSetNode * node = kvPair.second;
@@ -1,48 +1,147 @@
 #include <functional>
-#include <sstream>
 #include <stack>
 #include <queue>
+#include <deque>
 #include <limits>
 #include <algorithm>
+#include <mutex>
+#include <atomic>
 #include <assert.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
+#include "compact_graph.h"
+#include "dary_heap.h"
+#include "disjoint_set.h"
 #include "fibheap.h"
 #include "graph.h"
+#include "pairing_heap.h"
+#include "radix_heap.h"
+#include "thread_pool.h"
 
 typedef std::string vertex;
+typedef uint32_t vertex_id;
 typedef std::pair<vertex, vertex> edge;
 typedef std::vector<vertex> vertex_list;
 typedef std::unordered_set<vertex> vertex_set;
+typedef std::unordered_set<vertex_id> id_set;
+
+// Neighbor id and edge value share one record so relaxation loops read
+// both from the same contiguous array. Adjacency lists past a small
+// degree also keep an id -> position index for O(1) lookups.
+typedef Graph::Neighbor neighbor_entry;
+typedef BasicFibonacciHeap<vertex_id, float> sparse_id_heap;
+
+// Heap behind each of Graph's queue policies. All of them index vertex
+// ids through a flat array.
+template <typename Queue>
+struct id_queue;
+
+template <>
+struct id_queue<Graph::FibonacciQueue> {
+    typedef BasicFibonacciHeap<vertex_id, float, std::less<float>, heap_dense_index> type;
+};
+
+template <>
+struct id_queue<Graph::PairingQueue> {
+    typedef BasicPairingHeap<vertex_id, float, std::less<float>, heap_dense_index> type;
+};
+
+template <>
+struct id_queue<Graph::DaryQueue> {
+    typedef BasicDaryHeap<vertex_id, float, std::less<float>, heap_dense_index, 4> type;
+};
+
+template <>
+struct id_queue<Graph::RadixQueue> {
+    typedef BasicRadixHeap<vertex_id, float, heap_dense_index> type;
+};
+
+struct adjacency {
+    std::vector<neighbor_entry> entries;
+    std::unordered_map<vertex_id, size_t> index;
+};
+
+const size_t ADJACENCY_INDEX_THRESHOLD = 8;
+
+size_t findNeighbor(const adjacency & adj, vertex_id v) {
+    if (adj.entries.size() <= ADJACENCY_INDEX_THRESHOLD) {
+        for (size_t i = 0; i < adj.entries.size(); i++) {
+            if (adj.entries[i].id == v) return i;
+        }
+
+        return adj.entries.size();
+    }
+
+    std::unordered_map<vertex_id, size_t>::const_iterator it = adj.index.find(v);
+    return it != adj.index.end() ? it->second : adj.entries.size();
+}
 
-struct edge_hash {
-    size_t operator() (const edge & e) const {
-		std::ostringstream out;
-		out << e.first << ' ' << e.second;
-		return std::hash<std::string>()(out.str());
-	}
+void insertNeighbor(adjacency & adj, vertex_id v, float edgeValue) {
+    size_t pos = findNeighbor(adj, v);
+    if (pos != adj.entries.size()) {
+        adj.entries[pos].edgeValue = edgeValue;
+        return;
+    }
+
+    adj.entries.push_back({v, edgeValue});
+    if (adj.entries.size() <= ADJACENCY_INDEX_THRESHOLD) return;
+
+    if (adj.index.empty()) {
+        for (size_t i = 0; i < adj.entries.size(); i++) {
+            adj.index[adj.entries[i].id] = i;
+        }
+    } else {
+        adj.index[v] = pos;
+    }
+}
+
+void eraseNeighbor(adjacency & adj, vertex_id v) {
+    size_t pos = findNeighbor(adj, v);
+    if (pos == adj.entries.size()) return;
+
+    adj.entries[pos] = adj.entries.back();
+    adj.entries.pop_back();
+
+    if (adj.index.empty()) return;
+
+    adj.index.erase(v);
+    if (pos != adj.entries.size()) adj.index[adj.entries[pos].id] = pos;
+    if (adj.entries.size() <= ADJACENCY_INDEX_THRESHOLD) adj.index.clear();
+}
+
+// Copying a graph gives the copy its own, unlocked mutex.
+struct graph_mutex {
+    std::shared_mutex mutex;
+
+    graph_mutex() {}
+    graph_mutex(const graph_mutex &) {}
+    graph_mutex & operator=(const graph_mutex &) { return *this; }
 };
 
 struct Graph::ClassVars {
     bool directed;
     bool weighted;
-    vertex_set vertices;
-    std::unordered_map<vertex, vertex_set> neighborsMap;
-    std::unordered_map<edge, float, edge_hash> edgeValueMap;    
+    bool reverseIndexed;
+    std::unordered_map<vertex, vertex_id> idMap;
+    std::vector<vertex> names;
+    std::vector<bool> alive;
+    std::vector<vertex_id> freeIds;
+    std::vector<adjacency> adjacencyList;
+    std::vector<adjacency> incomingList;
+    graph_mutex lock;
 };
 
-Graph::Graph(bool directed, bool weighted) {
+Graph::Graph(bool directed, bool weighted, bool reverseIndexed) {
     this->ptr = new ClassVars;
     this->ptr->directed = directed;
     this->ptr->weighted = weighted;
+    this->ptr->reverseIndexed = directed && reverseIndexed;
 }
 
 Graph::Graph(const Graph & other) {
-    this->ptr = new ClassVars;
-    this->ptr->directed = other.ptr->directed;
-    this->ptr->weighted = other.ptr->weighted;
-    this->ptr->vertices = vertex_set(other.ptr->vertices);
-    this->ptr->neighborsMap = std::unordered_map<vertex, vertex_set>(other.ptr->neighborsMap);
-    this->ptr->edgeValueMap = std::unordered_map<edge, float, edge_hash>(other.ptr->edgeValueMap);
+    this->ptr = new ClassVars(*other.ptr);
 }
 
 Graph & Graph::operator=(const Graph & other) {
@@ -50,13 +149,7 @@ Graph & Graph::operator=(const Graph & other) {
 
     this->~Graph();
 
-    this->ptr = new ClassVars;
-    this->ptr->directed = other.ptr->directed;
-    this->ptr->weighted = other.ptr->weighted;
-    this->ptr->vertices = vertex_set(other.ptr->vertices);
-    this->ptr->neighborsMap = std::unordered_map<vertex, vertex_set>(other.ptr->neighborsMap);
-    this->ptr->edgeValueMap = std::unordered_map<edge, float, edge_hash>(other.ptr->edgeValueMap);
-
+    this->ptr = new ClassVars(*other.ptr);
     return *this;
 }
 
@@ -64,25 +157,77 @@ Graph::~Graph() {
     delete this->ptr;
 }
 
-bool Graph::empty() {
-    return this->ptr->vertices.size() == 0;
+std::shared_lock<std::shared_mutex> Graph::readLock() const {
+    return std::shared_lock<std::shared_mutex>(this->ptr->lock.mutex);
+}
+
+std::unique_lock<std::shared_mutex> Graph::writeLock() {
+    return std::unique_lock<std::shared_mutex>(this->ptr->lock.mutex);
+}
+
+bool Graph::empty() const {
+    return this->ptr->idMap.size() == 0;
+}
+
+bool Graph::isDirected() const {
+    return this->ptr->directed;
+}
+
+bool Graph::isWeighted() const {
+    return this->ptr->weighted;
 }
 
-vertex_set Graph::getVertices() {
-    return this->ptr->vertices;
+bool Graph::isReverseIndexed() const {
+    return this->ptr->reverseIndexed;
 }
-std::unordered_map<vertex, vertex_set> Graph::getEdges() {
-    return this->ptr->neighborsMap;
+
+vertex_set Graph::getVertices() const {
+    vertex_set vertices;
+    for (std::pair<vertex, vertex_id> kvPair : this->ptr->idMap) {
+        vertices.insert(kvPair.first);
+    }
+
+    return vertices;
 }
 
-bool Graph::isAdjacent(vertex a, vertex b) {
+std::unordered_map<vertex, vertex_set> Graph::getEdges() const {
+    std::unordered_map<vertex, vertex_set> edges;
+    for (std::pair<vertex, vertex_id> kvPair : this->ptr->idMap) {
+        edges[kvPair.first] = getNeighbors(kvPair.first);
+    }
+
+    return edges;
+}
+
+vertex_id Graph::getId(vertex v) const {
+    assert(hasVertex(v));
+    return this->ptr->idMap.at(v);
+}
+
+vertex Graph::getVertex(vertex_id id) const {
+    assert(hasVertex(id));
+    return this->ptr->names[id];
+}
+
+bool Graph::isAdjacent(vertex a, vertex b) const {
     if (!hasVertex(a) || !hasVertex(b)) return false;
 
-    return this->ptr->neighborsMap[a].find(b) != this->ptr->neighborsMap[a].end();
+    return isAdjacent(getId(a), getId(b));
 }
 
-bool Graph::hasVertex(vertex v) {
-    return this->ptr->vertices.find(v) != this->ptr->vertices.end();
+bool Graph::isAdjacent(vertex_id a, vertex_id b) const {
+    if (!hasVertex(a) || !hasVertex(b)) return false;
+
+    const adjacency & adj = this->ptr->adjacencyList[a];
+    return findNeighbor(adj, b) != adj.entries.size();
+}
+
+bool Graph::hasVertex(vertex v) const {
+    return this->ptr->idMap.find(v) != this->ptr->idMap.end();
+}
+
+bool Graph::hasVertex(vertex_id id) const {
+    return id < this->ptr->alive.size() && this->ptr->alive[id];
 }
 
 void Graph::flipEdge(vertex a, vertex b) {
@@ -93,161 +238,406 @@ void Graph::flipEdge(vertex a, vertex b) {
     addEdge(b, a, edgeValue);
 }
 
-void Graph::addVertex(vertex v) {
-    if (hasVertex(v)) return;
+vertex_id Graph::addVertex(vertex v) {
+    std::unordered_map<vertex, vertex_id>::const_iterator it = this->ptr->idMap.find(v);
+    if (it != this->ptr->idMap.end()) return it->second;
+
+    vertex_id id;
+    if (this->ptr->freeIds.empty()) {
+        id = this->ptr->names.size();
+        this->ptr->names.push_back(v);
+        this->ptr->alive.push_back(true);
+        this->ptr->adjacencyList.push_back(adjacency());
+        if (this->ptr->reverseIndexed) this->ptr->incomingList.push_back(adjacency());
+    } else {
+        id = this->ptr->freeIds.back();
+        this->ptr->freeIds.pop_back();
+        this->ptr->names[id] = v;
+        this->ptr->alive[id] = true;
+    }
 
-    this->ptr->vertices.insert(v);
-    this->ptr->neighborsMap[v] = vertex_set();
+    this->ptr->idMap[v] = id;
+    return id;
 }
 
 void Graph::setEdgeValue(vertex a, vertex b, float edgeValue) {
+    assert(isAdjacent(a, b));
+
+    setEdgeValue(getId(a), getId(b), edgeValue);
+}
+
+void Graph::setEdgeValue(vertex_id a, vertex_id b, float edgeValue) {
     assert(this->ptr->weighted);
     assert(isAdjacent(a, b));
 
-    this->ptr->edgeValueMap[edge(a, b)] = edgeValue;
-    if (!this->ptr->directed) this->ptr->edgeValueMap[edge(b, a)] = edgeValue;
+    insertNeighbor(this->ptr->adjacencyList[a], b, edgeValue);
+    if (!this->ptr->directed) insertNeighbor(this->ptr->adjacencyList[b], a, edgeValue);
+    if (this->ptr->reverseIndexed) insertNeighbor(this->ptr->incomingList[b], a, edgeValue);
 }
 
 void Graph::addEdge(vertex a, vertex b, float edgeValue) {
-    addVertex(a);
-    addVertex(b);
+    vertex_id u = addVertex(a);
+    vertex_id v = addVertex(b);
+
+    addEdge(u, v, edgeValue);
+}
 
-    this->ptr->neighborsMap[a].insert(b);
-    if (!this->ptr->directed) this->ptr->neighborsMap[b].insert(a);
+void Graph::addEdge(vertex_id a, vertex_id b, float edgeValue) {
+    assert(hasVertex(a) && hasVertex(b));
 
-    if (!this->ptr->weighted) return;
+    if (!this->ptr->weighted) edgeValue = 0;
 
-    setEdgeValue(a, b, edgeValue);
+    insertNeighbor(this->ptr->adjacencyList[a], b, edgeValue);
+    if (!this->ptr->directed) insertNeighbor(this->ptr->adjacencyList[b], a, edgeValue);
+    if (this->ptr->reverseIndexed) insertNeighbor(this->ptr->incomingList[b], a, edgeValue);
+}
+
+// One directed adjacency entry to add during a bulk insert. 'seq' keeps
+// the input order so the last of several duplicates wins, as it would
+// with repeated addEdge calls.
+struct pending_entry {
+    vertex_id source;
+    vertex_id target;
+    float edgeValue;
+    size_t seq;
+
+    bool operator<(const pending_entry & other) const {
+        if (source != other.source) return source < other.source;
+        if (target != other.target) return target < other.target;
+        return seq < other.seq;
+    }
+};
+
+// Sorts the pending entries by source and target and writes each source's
+// run into its list. An empty list is filled in one go with an exact
+// reservation; a non-empty one goes through insertNeighbor.
+void appendEntries(std::vector<adjacency> & lists, std::vector<pending_entry> & pending) {
+    std::sort(pending.begin(), pending.end());
+
+    size_t i = 0;
+    while (i < pending.size()) {
+        size_t end = i;
+        while (end < pending.size() && pending[end].source == pending[i].source) end++;
+
+        adjacency & adj = lists[pending[i].source];
+        bool fresh = adj.entries.empty();
+        if (fresh) adj.entries.reserve(end - i);
+
+        for (size_t j = i; j < end; j++) {
+            if (j + 1 < end && pending[j + 1].target == pending[j].target) continue;
+
+            if (fresh) adj.entries.push_back({pending[j].target, pending[j].edgeValue});
+            else insertNeighbor(adj, pending[j].target, pending[j].edgeValue);
+        }
+
+        if (fresh && adj.entries.size() > ADJACENCY_INDEX_THRESHOLD) {
+            adj.index.reserve(adj.entries.size());
+            for (size_t k = 0; k < adj.entries.size(); k++) {
+                adj.index[adj.entries[k].id] = k;
+            }
+        }
+
+        i = end;
+    }
+}
+
+void Graph::addEdges(const std::vector<std::tuple<vertex, vertex, float>> & edges) {
+    std::vector<pending_entry> outgoing;
+    std::vector<pending_entry> incoming;
+    outgoing.reserve(this->ptr->directed ? edges.size() : 2 * edges.size());
+    if (this->ptr->reverseIndexed) incoming.reserve(edges.size());
+
+    for (size_t seq = 0; seq < edges.size(); seq++) {
+        vertex_id a = addVertex(std::get<0>(edges[seq]));
+        vertex_id b = addVertex(std::get<1>(edges[seq]));
+        float edgeValue = this->ptr->weighted ? std::get<2>(edges[seq]) : 0;
+
+        outgoing.push_back({a, b, edgeValue, seq});
+        if (!this->ptr->directed) outgoing.push_back({b, a, edgeValue, seq});
+        if (this->ptr->reverseIndexed) incoming.push_back({b, a, edgeValue, seq});
+    }
+
+    appendEntries(this->ptr->adjacencyList, outgoing);
+    if (this->ptr->reverseIndexed) appendEntries(this->ptr->incomingList, incoming);
+}
+
+void Graph::save(vertex path) const {
+    CompactGraph(*this).save(path);
+}
+
+Graph Graph::fromEdges(bool directed, bool weighted, const std::vector<std::tuple<vertex, vertex, float>> & edges, bool reverseIndexed) {
+    Graph g(directed, weighted, reverseIndexed);
+    g.addEdges(edges);
+
+    return g;
 }
 
 void Graph::removeEdge(vertex a, vertex b) {
     if (!isAdjacent(a, b)) return;
 
-    this->ptr->neighborsMap[a].erase(b);
-    this->ptr->edgeValueMap.erase(edge(a, b));
+    removeEdge(getId(a), getId(b));
+}
+
+void Graph::removeEdge(vertex_id a, vertex_id b) {
+    if (!isAdjacent(a, b)) return;
+
+    eraseNeighbor(this->ptr->adjacencyList[a], b);
+    if (!this->ptr->directed) eraseNeighbor(this->ptr->adjacencyList[b], a);
+    if (this->ptr->reverseIndexed) eraseNeighbor(this->ptr->incomingList[b], a);
+}
+
+float Graph::getEdgeValue(vertex a, vertex b) const {
+    assert(isAdjacent(a, b));
 
-    if (!this->ptr->directed) {
-        this->ptr->neighborsMap[b].erase(a);
-        this->ptr->edgeValueMap.erase(edge(b, a));
-    }
+    return getEdgeValue(getId(a), getId(b));
 }
 
-float Graph::getEdgeValue(vertex a, vertex b) {
+float Graph::getEdgeValue(vertex_id a, vertex_id b) const {
     assert(this->ptr->weighted);
     assert(isAdjacent(a, b));
 
-    return this->ptr->edgeValueMap[edge(a, b)];
+    const adjacency & adj = this->ptr->adjacencyList[a];
+    return adj.entries[findNeighbor(adj, b)].edgeValue;
 }
 
-vertex_set Graph::getNeighbors(vertex v) {
+vertex_set Graph::getNeighbors(vertex v) const {
     assert(hasVertex(v));
-    return this->ptr->neighborsMap[v];
+
+    vertex_set neighbors;
+    for (neighbor_entry entry : this->ptr->adjacencyList[getId(v)].entries) {
+        neighbors.insert(this->ptr->names[entry.id]);
+    }
+
+    return neighbors;
 }
 
-vertex_set Graph::getIncomingNeighbors(vertex v) {
-    vertex_set vertices = getVertices();
-    vertex_set incomingNeighbors;
+id_set Graph::getNeighborIds(vertex_id v) const {
+    assert(hasVertex(v));
 
-    for (vertex u : vertices) {
-        if (!isAdjacent(u, v)) continue;
+    id_set neighbors;
+    for (neighbor_entry entry : this->ptr->adjacencyList[v].entries) {
+        neighbors.insert(entry.id);
+    }
+
+    return neighbors;
+}
 
-        incomingNeighbors.insert(u);
+Graph::NeighborView::NeighborView(const neighbor_entry * first, const neighbor_entry * last) {
+    this->first = first;
+    this->last = last;
+}
+
+const neighbor_entry * Graph::NeighborView::begin() const {
+    return this->first;
+}
+
+const neighbor_entry * Graph::NeighborView::end() const {
+    return this->last;
+}
+
+size_t Graph::NeighborView::size() const {
+    return this->last - this->first;
+}
+
+bool Graph::NeighborView::empty() const {
+    return this->first == this->last;
+}
+
+Graph::NeighborView Graph::neighbors(vertex v) const {
+    assert(hasVertex(v));
+    return neighbors(getId(v));
+}
+
+Graph::NeighborView Graph::neighbors(vertex_id v) const {
+    assert(hasVertex(v));
+
+    const std::vector<neighbor_entry> & entries = this->ptr->adjacencyList[v].entries;
+    return NeighborView(entries.data(), entries.data() + entries.size());
+}
+
+void Graph::forEachVertex(std::function<void(const vertex &)> callback) const {
+    for (const std::pair<const vertex, vertex_id> & kvPair : this->ptr->idMap) {
+        callback(kvPair.first);
+    }
+}
+
+void Graph::forEachNeighbor(vertex v, std::function<void(const vertex &, float)> callback) const {
+    for (neighbor_entry entry : neighbors(v)) {
+        callback(this->ptr->names[entry.id], entry.edgeValue);
+    }
+}
+
+void Graph::forEachEdge(std::function<void(const vertex &, const vertex &, float)> callback) const {
+    for (const std::pair<const vertex, vertex_id> & kvPair : this->ptr->idMap) {
+        for (neighbor_entry entry : neighbors(kvPair.second)) {
+            callback(kvPair.first, this->ptr->names[entry.id], entry.edgeValue);
+        }
+    }
+}
+
+vertex_set Graph::getIncomingNeighbors(vertex v) const {
+    vertex_set incoming;
+    if (!hasVertex(v)) return incoming;
+
+    vertex_id id = getId(v);
+    if (!this->ptr->directed || this->ptr->reverseIndexed) {
+        for (neighbor_entry entry : incomingNeighbors(id)) {
+            incoming.insert(this->ptr->names[entry.id]);
+        }
+
+        return incoming;
+    }
+
+    for (std::pair<vertex, vertex_id> kvPair : this->ptr->idMap) {
+        if (!isAdjacent(kvPair.second, id)) continue;
+
+        incoming.insert(kvPair.first);
     }
     
-    return incomingNeighbors;
+    return incoming;
+}
+
+Graph::NeighborView Graph::incomingNeighbors(vertex v) const {
+    assert(hasVertex(v));
+    return incomingNeighbors(getId(v));
+}
+
+Graph::NeighborView Graph::incomingNeighbors(vertex_id v) const {
+    assert(hasVertex(v));
+    assert(!this->ptr->directed || this->ptr->reverseIndexed);
+
+    if (!this->ptr->directed) return neighbors(v);
+
+    const std::vector<neighbor_entry> & entries = this->ptr->incomingList[v].entries;
+    return NeighborView(entries.data(), entries.data() + entries.size());
+}
+
+size_t Graph::getInDegree(vertex v) const {
+    assert(hasVertex(v));
+
+    if (!this->ptr->directed || this->ptr->reverseIndexed)
+        return incomingNeighbors(v).size();
+
+    return getIncomingNeighbors(v).size();
+}
+
+size_t Graph::getOutDegree(vertex v) const {
+    assert(hasVertex(v));
+    return neighbors(v).size();
 }
 
-bool Graph::isSourceVertex(vertex v) {
+bool Graph::isSourceVertex(vertex v) const {
     assert(hasVertex(v));
-    return getIncomingNeighbors(v).size() == 0;
+    return getInDegree(v) == 0;
 }
 
-bool Graph::isSinkVertex(vertex v) {
+bool Graph::isSinkVertex(vertex v) const {
     assert(hasVertex(v));
-    return getNeighbors(v).size() == 0;
+    return neighbors(v).empty();
 }
 
 void Graph::removeVertex(vertex v) {
     if (!hasVertex(v)) return;
 
-    vertex_set incomingNeighbors = getIncomingNeighbors(v);
-    vertex_set neighbors = getNeighbors(v);
-    for (vertex u : incomingNeighbors) {
-        removeEdge(u, v);
+    vertex_id id = getId(v);
+    std::vector<vertex_id> incomingNeighborIds;
+    if (!this->ptr->directed || this->ptr->reverseIndexed) {
+        for (neighbor_entry entry : incomingNeighbors(id)) {
+            incomingNeighborIds.push_back(entry.id);
+        }
+    } else {
+        for (vertex u : getIncomingNeighbors(v)) {
+            incomingNeighborIds.push_back(getId(u));
+        }
+    }
+
+    id_set neighbors = getNeighborIds(id);
+    for (vertex_id u : incomingNeighborIds) {
+        removeEdge(u, id);
     }
 
-    for (vertex u : neighbors) {
-        removeEdge(v, u);
+    for (vertex_id u : neighbors) {
+        removeEdge(id, u);
     }
 
-    this->ptr->vertices.erase(v);
+    this->ptr->idMap.erase(v);
+    this->ptr->names[id] = vertex();
+    this->ptr->alive[id] = false;
+    this->ptr->freeIds.push_back(id);
 }
 
-Graph Graph::reverse() {
+Graph Graph::reverse() const {
     assert(this->ptr->directed);
 
+    if (this->ptr->reverseIndexed) {
+        Graph revG(*this);
+        std::swap(revG.ptr->adjacencyList, revG.ptr->incomingList);
+        return revG;
+    }
+
     Graph revG(this->ptr->directed, this->ptr->weighted);
-    vertex_set vertices = getVertices();
-    float edgeValue = 0;
 
-    for (vertex u : vertices) {
-        revG.addVertex(u);
-        vertex_set neighbors = getNeighbors(u);
-        for (vertex v : neighbors) {
-            if (this->ptr->weighted) 
-                edgeValue = getEdgeValue(u, v);
+    for (const std::pair<const vertex, vertex_id> & kvPair : this->ptr->idMap) {
+        revG.addVertex(kvPair.first);
+    }
 
-            revG.addEdge(v, u, edgeValue);
+    for (const std::pair<const vertex, vertex_id> & kvPair : this->ptr->idMap) {
+        vertex_id u = revG.getId(kvPair.first);
+        for (neighbor_entry entry : neighbors(kvPair.second)) {
+            vertex_id v = revG.getId(this->ptr->names[entry.id]);
+            revG.addEdge(v, u, entry.edgeValue);
         }
     }
 
     return revG;
 }
 
-vertex_list Graph::dfs(vertex v) {
+vertex_list Graph::dfs(vertex v) const {
+    assert(hasVertex(v));
+
     vertex_list traversalList;
-    std::stack<vertex> stk;
-    vertex_set visited;
-    stk.push(v);
+    std::stack<vertex_id> stk;
+    std::vector<bool> visited(this->ptr->names.size(), false);
+    stk.push(getId(v));
 
     while (!stk.empty()) {
-        vertex u = stk.top();
+        vertex_id u = stk.top();
         stk.pop();
 
-        if (visited.find(u) != visited.end())
+        if (visited[u])
             continue;
 
-        visited.insert(u);
-        traversalList.push_back(u);
+        visited[u] = true;
+        traversalList.push_back(this->ptr->names[u]);
 
-        vertex_set neighbors = getNeighbors(u);
-        for (vertex neighbor : neighbors) {
-            stk.push(neighbor);
+        for (neighbor_entry entry : neighbors(u)) {
+            stk.push(entry.id);
         }
     }
 
     return traversalList;
 }
 
-vertex_list Graph::bfs(vertex v) {
+vertex_list Graph::bfs(vertex v) const {
+    assert(hasVertex(v));
+
     vertex_list traversalList;
-    std::queue<vertex> q;
-    vertex_set visited;
-    q.push(v);
+    std::queue<vertex_id> q;
+    std::vector<bool> visited(this->ptr->names.size(), false);
+    q.push(getId(v));
 
     while (!q.empty()) {
-        vertex u = q.front();
+        vertex_id u = q.front();
         q.pop();
 
-        if (visited.find(u) != visited.end())
+        if (visited[u])
             continue;
 
-        visited.insert(u);
-        traversalList.push_back(u);
+        visited[u] = true;
+        traversalList.push_back(this->ptr->names[u]);
 
-        vertex_set neighbors = getNeighbors(u);
-        for (vertex neighbor : neighbors) {
-            q.push(neighbor);
+        for (neighbor_entry entry : neighbors(u)) {
+            q.push(entry.id);
         }
     }
 
@@ -258,87 +648,467 @@ std::pair<
     std::unordered_map<vertex, float>, 
     std::unordered_map<vertex, vertex>
 >
-Graph::dijkstra(vertex v) {
+toVertexMaps(const Graph * g, const std::vector<float> & dist, const std::vector<vertex_id> & prev) {
+    std::unordered_map<vertex, float> distMap;
+    std::unordered_map<vertex, vertex> prevMap;
+
+    for (size_t u = 0; u < dist.size(); u++) {
+        if (!g->hasVertex((vertex_id) u)) continue;
+
+        distMap[g->getVertex(u)] = dist[u];
+        if (prev[u] != dist.size()) prevMap[g->getVertex(u)] = g->getVertex(prev[u]);
+    }
+
+    return std::pair<
+        std::unordered_map<vertex, float>, 
+        std::unordered_map<vertex, vertex>
+    >(distMap, prevMap);
+}
+
+template <typename Queue>
+std::pair<
+    std::unordered_map<vertex, float>, 
+    std::unordered_map<vertex, vertex>
+>
+Graph::dijkstra(vertex v) const {
     assert(hasVertex(v));
     assert(this->ptr->weighted);
 
-    std::unordered_map<vertex, float> dist;
-    std::unordered_map<vertex, vertex> prev;
+    size_t n = this->ptr->names.size();
+    std::vector<float> dist(n, std::numeric_limits<float>::max());
+    std::vector<vertex_id> prev(n, n);
+    std::vector<bool> settled(n, false);
 
-    FibonacciHeap pq = FibonacciHeap();
-    vertex_set vertices = getVertices();
-    float inf = std::numeric_limits<float>::max();
+    typename id_queue<Queue>::type pq;
+    pq.reserve(n);
 
-    for (vertex u : vertices) {
-        dist[u] = u != v ? inf : 0;
-        pq.push(u, dist[u]);
-    }
+    vertex_id s = getId(v);
+    dist[s] = 0;
+    pq.push(s, 0);
 
     while (!pq.empty()) {
-        vertex u = pq.top();
+        vertex_id u = pq.top();
         pq.pop();
+        settled[u] = true;
 
-        vertex_set neighbors = getNeighbors(u);
-        for (vertex neighbor : neighbors) {
-            if (!pq.contains(neighbor)) continue;
-            
-            float alt = dist[u] + getEdgeValue(u, neighbor);
-            if(alt >= dist[neighbor]) continue;
+        for (neighbor_entry entry : neighbors(u)) {
+            if (settled[entry.id]) continue;
 
-            dist[neighbor] = alt;
-            prev[neighbor] = u;
+            float alt = dist[u] + entry.edgeValue;
+            if (alt >= dist[entry.id]) continue;
+
+            dist[entry.id] = alt;
+            prev[entry.id] = u;
 
-            pq.decreaseKey(neighbor, alt);
+            if (pq.contains(entry.id)) pq.decreaseKey(entry.id, alt);
+            else pq.push(entry.id, alt);
         }
     }
 
-    return std::pair<
-        std::unordered_map<vertex, float>, 
-        std::unordered_map<vertex, vertex>
-    >(dist, prev);
+    return toVertexMaps(this, dist, prev);
+}
+
+template std::pair<std::unordered_map<vertex, float>, std::unordered_map<vertex, vertex>>
+Graph::dijkstra<Graph::FibonacciQueue>(vertex v) const;
+template std::pair<std::unordered_map<vertex, float>, std::unordered_map<vertex, vertex>>
+Graph::dijkstra<Graph::PairingQueue>(vertex v) const;
+template std::pair<std::unordered_map<vertex, float>, std::unordered_map<vertex, vertex>>
+Graph::dijkstra<Graph::DaryQueue>(vertex v) const;
+template std::pair<std::unordered_map<vertex, float>, std::unordered_map<vertex, vertex>>
+Graph::dijkstra<Graph::RadixQueue>(vertex v) const;
+
+// One direction of a point-to-point search. Vertices enter the heap only
+// once they are discovered, and 'dist' holds settled vertices only.
+struct SearchFrontier {
+    sparse_id_heap pq;
+    std::unordered_map<vertex_id, float> seen;
+    std::unordered_map<vertex_id, float> dist;
+    std::unordered_map<vertex_id, vertex_id> prev;
+};
+
+vertex_list buildPath(const Graph * g, std::unordered_map<vertex_id, vertex_id> & prev, vertex_id source, vertex_id target) {
+    vertex_list path;
+    for (vertex_id u = target; u != source; u = prev[u]) {
+        path.push_back(g->getVertex(u));
+    }
+
+    path.push_back(g->getVertex(source));
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+std::pair<vertex_list, float> Graph::shortestPath(vertex source, vertex target) const {
+    assert(hasVertex(source) && hasVertex(target));
+    assert(this->ptr->weighted);
+
+    vertex_id s = getId(source);
+    vertex_id t = getId(target);
+    SearchFrontier frontier;
+    frontier.seen[s] = 0;
+    frontier.pq.push(s, 0);
+
+    while (!frontier.pq.empty()) {
+        vertex_id u = frontier.pq.top();
+        frontier.pq.pop();
+        frontier.dist[u] = frontier.seen[u];
+
+        if (u == t) break;
+
+        for (neighbor_entry entry : neighbors(u)) {
+            if (frontier.dist.find(entry.id) != frontier.dist.end()) continue;
+
+            float alt = frontier.dist[u] + entry.edgeValue;
+            std::unordered_map<vertex_id, float>::iterator it = frontier.seen.find(entry.id);
+            if (it != frontier.seen.end() && alt >= it->second) continue;
+
+            if (it != frontier.seen.end()) frontier.pq.decreaseKey(entry.id, alt);
+            else frontier.pq.push(entry.id, alt);
+
+            frontier.seen[entry.id] = alt;
+            frontier.prev[entry.id] = u;
+        }
+    }
+
+    if (frontier.dist.find(t) == frontier.dist.end())
+        return std::pair<vertex_list, float>({}, std::numeric_limits<float>::max());
+
+    return std::pair<vertex_list, float>(buildPath(this, frontier.prev, s, t), frontier.dist[t]);
+}
+
+// A* over a consistent heuristic (never overestimates the remaining
+// cost and obeys the triangle inequality), so settled vertices are
+// final and never reopened.
+std::pair<vertex_list, float> Graph::aStar(vertex source, vertex target, std::function<float(const vertex &)> heuristic) const {
+    assert(hasVertex(source) && hasVertex(target));
+    assert(this->ptr->weighted);
+
+    vertex_id s = getId(source);
+    vertex_id t = getId(target);
+    SearchFrontier frontier;
+    frontier.seen[s] = 0;
+    frontier.pq.push(s, heuristic(source));
+
+    std::unordered_map<vertex_id, float> estimate;
+
+    while (!frontier.pq.empty()) {
+        vertex_id u = frontier.pq.top();
+        frontier.pq.pop();
+        frontier.dist[u] = frontier.seen[u];
+
+        if (u == t) break;
+
+        for (neighbor_entry entry : neighbors(u)) {
+            if (frontier.dist.find(entry.id) != frontier.dist.end()) continue;
+
+            float alt = frontier.dist[u] + entry.edgeValue;
+            std::unordered_map<vertex_id, float>::iterator it = frontier.seen.find(entry.id);
+            if (it != frontier.seen.end() && alt >= it->second) continue;
+
+            if (it == frontier.seen.end()) {
+                estimate[entry.id] = heuristic(this->ptr->names[entry.id]);
+                frontier.pq.push(entry.id, alt + estimate[entry.id]);
+            } else {
+                frontier.pq.decreaseKey(entry.id, alt + estimate[entry.id]);
+            }
+
+            frontier.seen[entry.id] = alt;
+            frontier.prev[entry.id] = u;
+        }
+    }
+
+    if (frontier.dist.find(t) == frontier.dist.end())
+        return std::pair<vertex_list, float>({}, std::numeric_limits<float>::max());
+
+    return std::pair<vertex_list, float>(buildPath(this, frontier.prev, s, t), frontier.dist[t]);
+}
+
+std::pair<vertex_list, float> Graph::bidirectionalShortestPath(vertex source, vertex target) const {
+    assert(hasVertex(source) && hasVertex(target));
+    assert(this->ptr->weighted);
+    assert(!this->ptr->directed || this->ptr->reverseIndexed);
+
+    vertex_id s = getId(source);
+    vertex_id t = getId(target);
+    float inf = std::numeric_limits<float>::max();
+    if (s == t) return std::pair<vertex_list, float>({source}, 0);
+
+    SearchFrontier frontiers[2];
+    frontiers[0].seen[s] = 0;
+    frontiers[0].pq.push(s, 0);
+    frontiers[1].seen[t] = 0;
+    frontiers[1].pq.push(t, 0);
+
+    float best = inf;
+    vertex_id meet = s;
+    size_t dir = 1;
+
+    // alternate directions; once a vertex is settled from both sides,
+    // 'best' holds the length of the shortest s-t path
+    while (!frontiers[0].pq.empty() && !frontiers[1].pq.empty()) {
+        dir = 1 - dir;
+        SearchFrontier & frontier = frontiers[dir];
+        SearchFrontier & other = frontiers[1 - dir];
+
+        vertex_id u = frontier.pq.top();
+        frontier.pq.pop();
+        frontier.dist[u] = frontier.seen[u];
+
+        if (other.dist.find(u) != other.dist.end()) break;
+
+        NeighborView edges = dir == 0 ? neighbors(u) : incomingNeighbors(u);
+        for (neighbor_entry entry : edges) {
+            if (frontier.dist.find(entry.id) != frontier.dist.end()) continue;
+
+            float alt = frontier.dist[u] + entry.edgeValue;
+            std::unordered_map<vertex_id, float>::iterator it = frontier.seen.find(entry.id);
+            if (it == frontier.seen.end() || alt < it->second) {
+                if (it != frontier.seen.end()) frontier.pq.decreaseKey(entry.id, alt);
+                else frontier.pq.push(entry.id, alt);
+
+                frontier.seen[entry.id] = alt;
+                frontier.prev[entry.id] = u;
+            }
+
+            std::unordered_map<vertex_id, float>::iterator otherIt = other.seen.find(entry.id);
+            if (otherIt == other.seen.end()) continue;
+
+            float total = frontier.seen[entry.id] + otherIt->second;
+            if (total >= best) continue;
+
+            best = total;
+            meet = entry.id;
+        }
+    }
+
+    if (best == inf) return std::pair<vertex_list, float>({}, inf);
+
+    vertex_list path = buildPath(this, frontiers[0].prev, s, meet);
+    for (vertex_id u = meet; u != t; ) {
+        u = frontiers[1].prev[u];
+        path.push_back(this->ptr->names[u]);
+    }
+
+    return std::pair<vertex_list, float>(path, best);
 }
 
 std::pair<
     std::unordered_map<vertex, float>, 
     std::unordered_map<vertex, vertex>
 >
-Graph::bellmanFord(vertex v) {
+Graph::bellmanFord(vertex v) const {
     assert(hasVertex(v));
     assert(this->ptr->weighted);
 
-    std::unordered_map<vertex, float> dist;
-    std::unordered_map<vertex, vertex> prev;
+    size_t n = this->ptr->names.size();
+    float inf = std::numeric_limits<float>::max();
+    std::vector<float> dist(n, inf);
+    std::vector<vertex_id> prev(n, n);
+    dist[getId(v)] = 0;
+
+    // stop as soon as a full pass leaves every distance unchanged
+    bool changed = true;
+    for (size_t it = 0; changed && it + 1 < this->ptr->idMap.size(); it++) {
+        changed = false;
+
+        for (vertex_id u = 0; u < n; u++) {
+            if (dist[u] == inf) continue;
+
+            NeighborView neighbors = this->neighbors(u);
+            for (neighbor_entry entry : neighbors) {
+                float alt = dist[u] + entry.edgeValue;
+                if (alt >= dist[entry.id]) continue; 
+
+                dist[entry.id] = alt;
+                prev[entry.id] = u;
+                changed = true;
+            }
+        }
+    }
 
-    vertex_set vertices = getVertices();
-    for (vertex u : vertices) {
-        dist[u] = std::numeric_limits<float>::max();
+    return toVertexMaps(this, dist, prev);
+}
+
+// Walks the predecessor pointers from every vertex and returns the first
+// cycle found, listed in edge order (the last vertex points back to the
+// first). Vertices without a predecessor hold prev.size().
+std::vector<vertex_id> findPredecessorCycle(const std::vector<vertex_id> & prev) {
+    size_t n = prev.size();
+    std::vector<size_t> walk(n, n);
+
+    for (size_t s = 0; s < n; s++) {
+        size_t u = s;
+        while (u < n && walk[u] == n) {
+            walk[u] = s;
+            u = prev[u];
+        }
+
+        if (u == n || walk[u] != s) continue;
+
+        std::vector<vertex_id> cycle;
+        size_t c = u;
+        do {
+            cycle.push_back(c);
+            c = prev[c];
+        } while (c != u);
+
+        std::reverse(cycle.begin(), cycle.end());
+        return cycle;
+    }
+
+    return std::vector<vertex_id>();
+}
+
+// Queue-based Bellman-Ford: only vertices whose distance dropped are
+// scanned again. Every n relaxations the predecessor graph is checked for
+// a cycle, which appears only once a negative cycle has been reached
+// (Cherkassky and Goldberg), so the search always terminates. Returns that
+// cycle, or an empty list once the distances have converged.
+std::vector<vertex_id> relaxQueue(const Graph * g, std::vector<float> & dist, std::vector<vertex_id> & prev, std::deque<vertex_id> & queue) {
+    size_t n = dist.size();
+    std::vector<bool> queued(n, false);
+    for (vertex_id u : queue) {
+        queued[u] = true;
     }
-    dist[v] = 0;
 
-    for (size_t it = 0; it < vertices.size() - 1; it++) {
-        for (vertex u : vertices) {
-            vertex_set neighbors = getNeighbors(u);
-            for (vertex neighbor : neighbors) {
-                float alt = dist[u] + getEdgeValue(u, neighbor);
-                if (alt >= dist[neighbor]) continue; 
+    size_t relaxations = 0;
+    while (!queue.empty()) {
+        vertex_id u = queue.front();
+        queue.pop_front();
+        queued[u] = false;
+
+        Graph::NeighborView neighbors = g->neighbors(u);
+        for (neighbor_entry entry : neighbors) {
+            float alt = dist[u] + entry.edgeValue;
+            if (alt >= dist[entry.id]) continue;
 
-                dist[neighbor] = alt;
-                prev[neighbor] = u;
+            dist[entry.id] = alt;
+            prev[entry.id] = u;
+
+            if (++relaxations % n == 0) {
+                std::vector<vertex_id> cycle = findPredecessorCycle(prev);
+                if (!cycle.empty()) return cycle;
             }
+
+            if (queued[entry.id]) continue;
+
+            queued[entry.id] = true;
+            queue.push_back(entry.id);
         }
     }
 
-    return std::pair<
-        std::unordered_map<vertex, float>, 
-        std::unordered_map<vertex, vertex>
-    >(dist, prev);
+    return std::vector<vertex_id>();
+}
+
+std::pair<
+    std::unordered_map<vertex, float>, 
+    std::unordered_map<vertex, vertex>
+>
+Graph::spfa(vertex v) const {
+    assert(hasVertex(v));
+    assert(this->ptr->weighted);
+
+    size_t n = this->ptr->names.size();
+    std::vector<float> dist(n, std::numeric_limits<float>::max());
+    std::vector<vertex_id> prev(n, n);
+    std::deque<vertex_id> queue;
+
+    dist[getId(v)] = 0;
+    queue.push_back(getId(v));
+
+    std::vector<vertex_id> cycle = relaxQueue(this, dist, prev, queue);
+    if (!cycle.empty()) {
+        return std::pair<
+            std::unordered_map<vertex, float>,
+            std::unordered_map<vertex, vertex>
+        >();
+    }
+
+    return toVertexMaps(this, dist, prev);
+}
+
+vertex_list Graph::negativeCycle() const {
+    assert(this->ptr->weighted);
+
+    // a virtual source with a zero-weight edge to every vertex reaches
+    // every cycle in the graph
+    size_t n = this->ptr->names.size();
+    std::vector<float> dist(n, 0);
+    std::vector<vertex_id> prev(n, n);
+    std::deque<vertex_id> queue;
+
+    for (vertex_id u = 0; u < n; u++) {
+        if (hasVertex(u)) queue.push_back(u);
+    }
+
+    vertex_list cycle;
+    for (vertex_id u : relaxQueue(this, dist, prev, queue)) {
+        cycle.push_back(this->ptr->names[u]);
+    }
+
+    return cycle;
+}
+
+// Floyd-Warshall runs over a flat row-major matrix in square tiles
+// (Venkataraman et al.): for each diagonal tile, first close the tile
+// itself, then the tiles in its row and column, then every remaining
+// tile. Tiles within the last two phases are independent of each other.
+const size_t FLOYD_WARSHALL_TILE = 64;
+
+struct tile_matrix {
+    float * dist;
+    int * next;
+    size_t n;
+};
+
+// C = min(C, A (+) B) over one tile, where A is the tile in C's rows and
+// the pivot columns, and B the tile in the pivot rows and C's columns.
+// Any of the three may alias when they lie on the pivot row or column.
+void minPlusTile(tile_matrix & m, size_t ci, size_t cj, size_t ki, size_t rows, size_t cols, size_t depth) {
+    size_t n = m.n;
+
+    for (size_t k = 0; k < depth; k++) {
+        const float * bRow = m.dist + (ki + k) * n + cj;
+
+        for (size_t i = 0; i < rows; i++) {
+            float * cRow = m.dist + (ci + i) * n + cj;
+            int * nRow = m.next + (ci + i) * n + cj;
+            float aik = m.dist[(ci + i) * n + ki + k];
+            int nik = m.next[(ci + i) * n + ki + k];
+            size_t j = 0;
+
+#ifdef __SSE2__
+            __m128 a = _mm_set1_ps(aik);
+            __m128i nk = _mm_set1_epi32(nik);
+            for (; j + 4 <= cols; j += 4) {
+                __m128 c = _mm_loadu_ps(cRow + j);
+                __m128 alt = _mm_add_ps(a, _mm_loadu_ps(bRow + j));
+                __m128i improved = _mm_castps_si128(_mm_cmplt_ps(alt, c));
+                __m128i nc = _mm_loadu_si128((__m128i *) (nRow + j));
+
+                _mm_storeu_ps(cRow + j, _mm_min_ps(alt, c));
+                _mm_storeu_si128((__m128i *) (nRow + j), _mm_or_si128(
+                    _mm_and_si128(improved, nk),
+                    _mm_andnot_si128(improved, nc)
+                ));
+            }
+#endif
+
+            for (; j < cols; j++) {
+                float alt = aik + bRow[j];
+                if (cRow[j] <= alt) continue;
+
+                cRow[j] = alt;
+                nRow[j] = nik;
+            }
+        }
+    }
 }
 
 std::pair<
     std::vector<std::vector<float>>,
     std::vector<std::vector<int>>
 >
-Graph::floydWarshall() {
+Graph::floydWarshall(size_t threads) const {
     assert(this->ptr->directed && this->ptr->weighted);
     
     vertex_set vertices = getVertices();
@@ -347,203 +1117,716 @@ Graph::floydWarshall() {
     size_t n = vertices.size();
 
     float inf = std::numeric_limits<float>::max();
-    std::vector<std::vector<float>> dist(n, std::vector<float>(n, inf));
-    std::vector<std::vector<int>> next(n, std::vector<int>(n, -1));
+    std::vector<float> flatDist(n * n, inf);
+    std::vector<int> flatNext(n * n, -1);
+
+    std::vector<size_t> position(this->ptr->names.size());
+    for (size_t i = 0; i < n; i++) {
+        position[getId(verticesList[i])] = i;
+    }
 
     for (size_t i = 0; i < n; i++) {
-        for (size_t j = 0; j < n; j++) {
-            vertex a = verticesList[i];
-            vertex b = verticesList[j];
+        NeighborView neighbors = this->neighbors(getId(verticesList[i]));
+        for (neighbor_entry entry : neighbors) {
+            size_t j = position[entry.id];
 
-            if (!isAdjacent(a, b)) continue;
-            
-            dist[i][j] = getEdgeValue(a, b);
-            next[i][j] = j;
+            flatDist[i * n + j] = entry.edgeValue;
+            flatNext[i * n + j] = j;
         }
 
-        dist[i][i] = 0;
-        next[i][i] = i;
+        flatDist[i * n + i] = 0;
+        flatNext[i * n + i] = i;
     }
 
-    for (size_t k = 0; k < n; k++) {
-        for (size_t i = 0; i < n; i++) {
-            for (size_t j = 0; j < n; j++) {
-                float alt = dist[i][k] + dist[k][j];
-                if (dist[i][j] <= alt) continue;
+    ThreadPool pool(threads);
+    tile_matrix m = {flatDist.data(), flatNext.data(), n};
+    size_t tile = FLOYD_WARSHALL_TILE;
+    size_t tiles = (n + tile - 1) / tile;
+
+    for (size_t kb = 0; kb < tiles; kb++) {
+        size_t k0 = kb * tile;
+        size_t depth = std::min(tile, n - k0);
+
+        minPlusTile(m, k0, k0, k0, depth, depth, depth);
+
+        pool.parallelFor(tiles, [&](size_t begin, size_t end, size_t) {
+            for (size_t b = begin; b < end; b++) {
+                if (b == kb) continue;
 
-                dist[i][j] = alt;
-                next[i][j] = next[i][k];
+                size_t extent = std::min(tile, n - b * tile);
+                minPlusTile(m, k0, b * tile, k0, depth, extent, depth);
+                minPlusTile(m, b * tile, k0, k0, extent, depth, depth);
             }
+        });
+
+        pool.parallelFor(tiles * tiles, [&](size_t begin, size_t end, size_t) {
+            for (size_t b = begin; b < end; b++) {
+                size_t ib = b / tiles;
+                size_t jb = b % tiles;
+                if (ib == kb || jb == kb) continue;
+
+                size_t rows = std::min(tile, n - ib * tile);
+                size_t cols = std::min(tile, n - jb * tile);
+                minPlusTile(m, ib * tile, jb * tile, k0, rows, cols, depth);
+            }
+        });
+    }
+
+    std::vector<std::vector<float>> dist(n);
+    std::vector<std::vector<int>> next(n);
+    for (size_t i = 0; i < n; i++) {
+        dist[i].assign(flatDist.begin() + i * n, flatDist.begin() + (i + 1) * n);
+        next[i].assign(flatNext.begin() + i * n, flatNext.begin() + (i + 1) * n);
+    }
+
+    return std::pair<
+        std::vector<std::vector<float>>,
+        std::vector<std::vector<int>>
+    >(dist, next);
+}
+
+// Johnson's algorithm reweights every edge to w(u, v) + h(u) - h(v) >= 0,
+// where h is the shortest distance from a virtual source joined to every
+// vertex by a zero-weight edge, and then runs one Dijkstra per source.
+// Vertices are addressed by their position in sorted order, as in
+// floydWarshall. If the virtual source reaches a negative cycle there is
+// no such h, and 'cycle' holds the cycle instead.
+struct reweighted_graph {
+    std::vector<size_t> offsets;
+    std::vector<int> targets;
+    std::vector<float> weights;
+    std::vector<float> potential;
+    std::vector<vertex_id> cycle;
+};
+
+reweighted_graph reweight(const Graph * g, const vertex_list & vertices, size_t numIds) {
+    size_t n = vertices.size();
+    reweighted_graph r;
+
+    // h comes from the same queue-based search as negativeCycle()
+    std::vector<float> dist(numIds, 0);
+    std::vector<vertex_id> prev(numIds, numIds);
+    std::deque<vertex_id> queue;
+    for (const vertex & v : vertices) {
+        queue.push_back(g->getId(v));
+    }
+
+    r.cycle = relaxQueue(g, dist, prev, queue);
+    if (!r.cycle.empty()) return r;
+
+    std::vector<int> position(numIds);
+    r.potential.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        vertex_id id = g->getId(vertices[i]);
+        position[id] = i;
+        r.potential[i] = dist[id];
+    }
+
+    r.offsets.push_back(0);
+    for (size_t i = 0; i < n; i++) {
+        Graph::NeighborView neighbors = g->neighbors(g->getId(vertices[i]));
+        for (neighbor_entry entry : neighbors) {
+            r.targets.push_back(position[entry.id]);
+            r.weights.push_back(entry.edgeValue);
+        }
+
+        r.offsets.push_back(r.targets.size());
+    }
+
+    for (size_t u = 0; u < n; u++) {
+        for (size_t e = r.offsets[u]; e < r.offsets[u + 1]; e++) {
+            float w = r.weights[e] + r.potential[u] - r.potential[r.targets[e]];
+            r.weights[e] = std::max(0.0f, w);
+        }
+    }
+
+    return r;
+}
+
+// Fills one row of the distance and next-hop matrices. Vertices are
+// settled in distance order, so a vertex's predecessor always has its
+// next hop assigned before the vertex itself.
+void johnsonRow(const reweighted_graph & r, int s, std::vector<float> & dist, std::vector<int> & next) {
+    size_t n = r.potential.size();
+    float inf = std::numeric_limits<float>::max();
+    dist.assign(n, inf);
+    next.assign(n, -1);
+
+    std::vector<int> prev(n, -1);
+    std::vector<bool> settled(n, false);
+    std::vector<int> order;
+
+    typedef std::pair<float, int> entry;
+    std::priority_queue<entry, std::vector<entry>, std::greater<entry>> pq;
+
+    dist[s] = 0;
+    pq.push(entry(0, s));
+
+    while (!pq.empty()) {
+        int u = pq.top().second;
+        pq.pop();
+
+        if (settled[u]) continue;
+        settled[u] = true;
+        order.push_back(u);
+
+        for (size_t e = r.offsets[u]; e < r.offsets[u + 1]; e++) {
+            int neighbor = r.targets[e];
+            if (settled[neighbor]) continue;
+
+            float alt = dist[u] + r.weights[e];
+            if (alt >= dist[neighbor]) continue;
+
+            dist[neighbor] = alt;
+            prev[neighbor] = u;
+            pq.push(entry(alt, neighbor));
         }
     }
 
+    next[s] = s;
+    for (int u : order) {
+        if (u == s) continue;
+
+        next[u] = prev[u] == s ? u : next[prev[u]];
+        dist[u] += r.potential[u] - r.potential[s];
+    }
+}
+
+void johnsonRows(const reweighted_graph & r, size_t threads, std::function<void(int, std::vector<float> &, std::vector<int> &)> visit) {
+    ThreadPool pool(threads);
+    std::vector<std::vector<float>> dist(pool.size());
+    std::vector<std::vector<int>> next(pool.size());
+
+    pool.parallelFor(r.potential.size(), [&](size_t begin, size_t end, size_t worker) {
+        for (size_t s = begin; s < end; s++) {
+            johnsonRow(r, s, dist[worker], next[worker]);
+            visit(s, dist[worker], next[worker]);
+        }
+    });
+}
+
+std::pair<
+    std::vector<std::vector<float>>,
+    std::vector<std::vector<int>>
+>
+Graph::johnson(size_t threads) const {
+    assert(this->ptr->directed && this->ptr->weighted);
+
+    vertex_set vertices = getVertices();
+    vertex_list verticesList(vertices.begin(), vertices.end());
+    std::sort(verticesList.begin(), verticesList.end());
+    size_t n = vertices.size();
+
+    reweighted_graph r = reweight(this, verticesList, this->ptr->names.size());
+    if (!r.cycle.empty()) {
+        return std::pair<
+            std::vector<std::vector<float>>,
+            std::vector<std::vector<int>>
+        >();
+    }
+
+    std::vector<std::vector<float>> dist(n);
+    std::vector<std::vector<int>> next(n);
+
+    johnsonRows(r, threads, [&](int s, std::vector<float> & rowDist, std::vector<int> & rowNext) {
+        dist[s] = rowDist;
+        next[s] = rowNext;
+    });
+
     return std::pair<
         std::vector<std::vector<float>>,
         std::vector<std::vector<int>>
     >(dist, next);
 }
 
-std::vector<edge> Graph::mst() {
-    assert(this->ptr->weighted);
+void Graph::johnson(std::function<void(const vertex &, const std::vector<float> &, const std::vector<int> &)> callback, size_t threads) const {
+    assert(this->ptr->directed && this->ptr->weighted);
 
     vertex_set vertices = getVertices();
-    FibonacciHeap heap = FibonacciHeap();
-    
+    vertex_list verticesList(vertices.begin(), vertices.end());
+    std::sort(verticesList.begin(), verticesList.end());
+
+    reweighted_graph r = reweight(this, verticesList, this->ptr->names.size());
+    if (!r.cycle.empty()) return;
+
+    std::mutex callbackMutex;
+
+    johnsonRows(r, threads, [&](int s, std::vector<float> & rowDist, std::vector<int> & rowNext) {
+        std::unique_lock<std::mutex> lock(callbackMutex);
+        callback(verticesList[s], rowDist, rowNext);
+    });
+}
+
+edge orderedEdge(const vertex & a, const vertex & b) {
+    return a < b ? edge(a, b) : edge(b, a);
+}
+
+// Prim's algorithm restarted from every vertex not yet in the forest.
+template <typename Queue>
+std::vector<edge> primForest(const Graph * g, const std::vector<vertex> & names) {
+    size_t n = names.size();
     float inf = std::numeric_limits<float>::max();
-    std::unordered_map<vertex, float> cost;
-    std::unordered_map<vertex, vertex> prev;
+    std::vector<float> cost(n, inf);
+    std::vector<vertex_id> prev(n, n);
+    std::vector<bool> inTree(n, false);
+    std::vector<edge> tree;
+    typename id_queue<Queue>::type heap;
+    heap.reserve(n);
+
+    for (vertex_id root = 0; root < n; root++) {
+        if (!g->hasVertex(root) || inTree[root]) continue;
+
+        cost[root] = 0;
+        heap.push(root, 0);
+
+        while (!heap.empty()) {
+            vertex_id u = heap.top();
+            heap.pop();
+            inTree[u] = true;
+
+            if (prev[u] != n) tree.push_back(orderedEdge(names[prev[u]], names[u]));
 
-    for (vertex v : vertices) {
-        cost[v] = inf;
+            Graph::NeighborView neighbors = g->neighbors(u);
+            for (neighbor_entry entry : neighbors) {
+                vertex_id v = entry.id;
+                if (inTree[v] || cost[v] <= entry.edgeValue) continue;
+
+                cost[v] = entry.edgeValue;
+                prev[v] = u;
+
+                if (heap.contains(v)) heap.decreaseKey(v, cost[v]);
+                else heap.push(v, cost[v]);
+            }
+        }
     }
 
-    vertex v = *vertices.begin();
-    cost[v] = 0;
+    return tree;
+}
 
-    for (vertex u : vertices) {
-        heap.push(u, cost[u]);
+// Edges are compared by weight and then by endpoints, so every edge has
+// a distinct rank. Boruvka relies on this to never pick a cycle.
+struct weighted_edge {
+    float weight;
+    vertex_id a;
+    vertex_id b;
+
+    bool operator<(const weighted_edge & other) const {
+        if (weight != other.weight) return weight < other.weight;
+        if (a != other.a) return a < other.a;
+        return b < other.b;
     }
+};
 
-    while (!heap.empty()) {
-        vertex u = heap.top();
-        heap.pop();
+std::vector<weighted_edge> getWeightedEdges(const Graph * g, size_t n) {
+    std::vector<weighted_edge> edges;
 
-        vertex_set neighbors = getNeighbors(u);
-        for (vertex v : neighbors) {
-            if (!heap.contains(v)) continue;
+    for (vertex_id u = 0; u < n; u++) {
+        if (!g->hasVertex(u)) continue;
 
-            float edgeWeight = getEdgeValue(u, v);
-            if (cost[v] <= edgeWeight) continue;
+        Graph::NeighborView neighbors = g->neighbors(u);
+        for (neighbor_entry entry : neighbors) {
+            if (u == entry.id) continue;
+            if (!g->isDirected() && entry.id < u) continue;
 
-            cost[v] = edgeWeight;
-            prev[v] = u;
-            heap.decreaseKey(v, cost[v]);
+            edges.push_back(weighted_edge{entry.edgeValue, std::min(u, entry.id), std::max(u, entry.id)});
         }
     }
 
-    std::unordered_set<edge, edge_hash> mstSet;
-    for (vertex v : vertices) {
-        if (prev.find(v) == prev.end()) continue;
+    return edges;
+}
+
+// Sorts equal chunks on separate threads, then merges neighbouring runs
+// pairwise until a single run is left.
+void parallelSort(std::vector<weighted_edge> & edges, ThreadPool & pool) {
+    size_t chunks = std::min(pool.size(), std::max((size_t) 1, edges.size()));
+    std::vector<size_t> bounds;
+    for (size_t c = 0; c <= chunks; c++) {
+        bounds.push_back(edges.size() * c / chunks);
+    }
+
+    pool.parallelFor(chunks, [&](size_t begin, size_t end, size_t) {
+        for (size_t c = begin; c < end; c++) {
+            std::sort(edges.begin() + bounds[c], edges.begin() + bounds[c + 1]);
+        }
+    });
+
+    for (size_t width = 1; width < chunks; width *= 2) {
+        size_t merges = (chunks + 2 * width - 1) / (2 * width);
+
+        pool.parallelFor(merges, [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; i++) {
+                size_t first = 2 * width * i;
+                size_t middle = std::min(first + width, chunks);
+                size_t last = std::min(first + 2 * width, chunks);
+
+                std::inplace_merge(
+                    edges.begin() + bounds[first],
+                    edges.begin() + bounds[middle],
+                    edges.begin() + bounds[last]
+                );
+            }
+        });
+    }
+}
+
+std::vector<edge> kruskalForest(const Graph * g, const std::vector<vertex> & names, ThreadPool & pool) {
+    std::vector<weighted_edge> edges = getWeightedEdges(g, names.size());
+    parallelSort(edges, pool);
+
+    DisjointSet components(names.size());
+    std::vector<edge> tree;
+
+    for (const weighted_edge & e : edges) {
+        if (components.find(e.a) == components.find(e.b)) continue;
+
+        components.setUnion(e.a, e.b);
+        tree.push_back(orderedEdge(names[e.a], names[e.b]));
+    }
+
+    return tree;
+}
 
-        edge e = prev[v] < v ? edge(prev[v], v) : edge(v, prev[v]);
-        mstSet.insert(e);
+// Each round every component picks its cheapest outgoing edge and all of
+// them are merged at once. The component labels are read out of the
+// DisjointSet before the parallel scan, since find() compresses paths.
+// Lowers a component's cheapest edge to edge i if i orders before it;
+// 'none' (edges.size()) marks a component with no candidate yet.
+void offerCheapest(std::atomic<size_t> & slot, size_t i, const std::vector<weighted_edge> & edges) {
+    size_t none = edges.size();
+    size_t current = slot.load(std::memory_order_relaxed);
+
+    while (current == none || edges[i] < edges[current]) {
+        if (slot.compare_exchange_weak(current, i, std::memory_order_relaxed)) return;
     }
+}
+
+// Every round each component picks its cheapest outgoing edge. Workers
+// share one slot per component and lower it with a compare-and-swap, so
+// memory stays at one array of n slots whatever the thread count.
+std::vector<edge> boruvkaForest(const Graph * g, const std::vector<vertex> & names, ThreadPool & pool) {
+    size_t n = names.size();
+    std::vector<weighted_edge> edges = getWeightedEdges(g, n);
+    DisjointSet components(n);
+    std::vector<size_t> label(n);
+    std::vector<edge> tree;
+
+    size_t none = edges.size();
+    std::vector<std::atomic<size_t>> cheapest(n);
+
+    while (true) {
+        for (size_t u = 0; u < n; u++) {
+            label[u] = components.find(u);
+            cheapest[u].store(none, std::memory_order_relaxed);
+        }
+
+        pool.parallelFor(edges.size(), [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; i++) {
+                size_t a = label[edges[i].a];
+                size_t b = label[edges[i].b];
+                if (a == b) continue;
+
+                offerCheapest(cheapest[a], i, edges);
+                offerCheapest(cheapest[b], i, edges);
+            }
+        });
 
-    return std::vector<edge>(mstSet.begin(), mstSet.end());
+        bool merged = false;
+        for (size_t c = 0; c < n; c++) {
+            if (label[c] != c) continue;
+
+            size_t pick = cheapest[c].load(std::memory_order_relaxed);
+            if (pick == none) continue;
+
+            const weighted_edge & e = edges[pick];
+            if (components.find(e.a) == components.find(e.b)) continue;
+
+            components.setUnion(e.a, e.b);
+            tree.push_back(orderedEdge(names[e.a], names[e.b]));
+            merged = true;
+        }
+
+        if (!merged) break;
+    }
+
+    return tree;
 }
 
-vertex_list Graph::topologicalSort() {
+template <typename Queue>
+std::vector<edge> Graph::mst(MstAlgorithm algorithm, size_t threads) const {
+    assert(this->ptr->weighted);
+
+    if (algorithm == PRIM) return primForest<Queue>(this, this->ptr->names);
+
+    ThreadPool pool(threads);
+    if (algorithm == KRUSKAL) return kruskalForest(this, this->ptr->names, pool);
+
+    return boruvkaForest(this, this->ptr->names, pool);
+}
+
+template std::vector<edge> Graph::mst<Graph::FibonacciQueue>(MstAlgorithm algorithm, size_t threads) const;
+template std::vector<edge> Graph::mst<Graph::PairingQueue>(MstAlgorithm algorithm, size_t threads) const;
+template std::vector<edge> Graph::mst<Graph::DaryQueue>(MstAlgorithm algorithm, size_t threads) const;
+
+std::vector<size_t> getInDegrees(const Graph * g, size_t idCount) {
+    std::vector<size_t> inDegree(idCount, 0);
+    g->forEachVertex([&](const vertex & v) {
+        for (neighbor_entry entry : g->neighbors(v)) {
+            inDegree[entry.id]++;
+        }
+    });
+
+    return inDegree;
+}
+
+vertex_list Graph::topologicalSort() const {
     assert(this->ptr->directed);
 
-    Graph clone(*this);
+    std::vector<size_t> inDegree = getInDegrees(this, this->ptr->names.size());
     vertex_list tps;
-    vertex_set vertices = getVertices();
-    std::stack<vertex> stk;
+    std::stack<vertex_id> stk;
 
-    for (vertex v : vertices) {
-        if (!isSourceVertex(v)) continue;
+    for (const std::pair<const vertex, vertex_id> & kvPair : this->ptr->idMap) {
+        if (inDegree[kvPair.second] != 0) continue;
 
-        stk.push(v);
+        stk.push(kvPair.second);
     }
 
     while (!stk.empty()) {
-        vertex sourceVertex = stk.top();
+        vertex_id sourceVertex = stk.top();
         stk.pop();
-        tps.push_back(sourceVertex);
+        tps.push_back(this->ptr->names[sourceVertex]);
 
-        vertex_set neighbors = clone.getNeighbors(sourceVertex);
-        for (vertex neighbor : neighbors) {
-            clone.removeEdge(sourceVertex, neighbor);
-            if (!clone.isSourceVertex(neighbor)) 
+        for (neighbor_entry entry : neighbors(sourceVertex)) {
+            if (--inDegree[entry.id] != 0)
                 continue;
 
-            stk.push(neighbor);
+            stk.push(entry.id);
         }
     }
 
-    for (vertex v : vertices) {
-        if (clone.getNeighbors(v).size() == 0) continue;
+    if (tps.size() != this->ptr->idMap.size()) return {};
 
-        return {};
+    return tps;
+}
+
+enum SchedulerState { WAITING, READY, RUNNING, COMPLETE };
+
+struct TopologicalScheduler::ClassVars {
+    const Graph * graph;
+    std::vector<size_t> inDegree;
+    std::vector<SchedulerState> state;
+    std::vector<vertex_id> ready;
+    size_t pending;
+    size_t inFlight;
+};
+
+TopologicalScheduler::TopologicalScheduler(const Graph & g) {
+    assert(g.isDirected());
+
+    this->ptr = new ClassVars;
+    this->ptr->graph = &g;
+    this->ptr->pending = 0;
+    this->ptr->inFlight = 0;
+
+    size_t idCount = 0;
+    g.forEachVertex([&](const vertex & v) {
+        idCount = std::max(idCount, (size_t) g.getId(v) + 1);
+    });
+
+    this->ptr->inDegree = getInDegrees(&g, idCount);
+    this->ptr->state = std::vector<SchedulerState>(idCount, COMPLETE);
+
+    g.forEachVertex([&](const vertex & v) {
+        vertex_id id = g.getId(v);
+        this->ptr->pending++;
+        this->ptr->state[id] = WAITING;
+
+        if (this->ptr->inDegree[id] != 0) return;
+
+        this->ptr->state[id] = READY;
+        this->ptr->ready.push_back(id);
+    });
+}
+
+TopologicalScheduler::TopologicalScheduler(const TopologicalScheduler & other) {
+    this->ptr = new ClassVars(*other.ptr);
+}
+
+TopologicalScheduler & TopologicalScheduler::operator=(const TopologicalScheduler & other) {
+    if (this == &other) return *this;
+
+    this->~TopologicalScheduler();
+
+    this->ptr = new ClassVars(*other.ptr);
+    return *this;
+}
+
+TopologicalScheduler::~TopologicalScheduler() {
+    delete this->ptr;
+}
+
+bool TopologicalScheduler::hasReady() {
+    return !this->ptr->ready.empty();
+}
+
+vertex TopologicalScheduler::next() {
+    assert(hasReady());
+
+    vertex_id id = this->ptr->ready.back();
+    this->ptr->ready.pop_back();
+    this->ptr->state[id] = RUNNING;
+    this->ptr->inFlight++;
+
+    return this->ptr->graph->getVertex(id);
+}
+
+void TopologicalScheduler::complete(vertex v) {
+    const Graph * g = this->ptr->graph;
+    vertex_id id = g->getId(v);
+    assert(this->ptr->state[id] == RUNNING);
+
+    this->ptr->state[id] = COMPLETE;
+    this->ptr->inFlight--;
+    this->ptr->pending--;
+
+    for (neighbor_entry entry : g->neighbors(id)) {
+        if (--this->ptr->inDegree[entry.id] != 0) continue;
+
+        this->ptr->state[entry.id] = READY;
+        this->ptr->ready.push_back(entry.id);
     }
+}
 
-    return tps;
+size_t TopologicalScheduler::inFlight() {
+    return this->ptr->inFlight;
+}
+
+bool TopologicalScheduler::done() {
+    return this->ptr->pending == 0;
 }
 
-void dfsHelper(Graph * g, vertex & v, vertex_list & L) {
-    static vertex_set visited;
+bool TopologicalScheduler::hasCycle() {
+    return !done() && !hasReady() && inFlight() == 0;
+}
 
-    std::stack<vertex> stk;
-    std::stack<vertex> dfs;
-    stk.push(v);
+// Iterative Tarjan over vertex ids. Components are completed in reverse
+// topological order of the condensation, so their ids are flipped at the
+// end to number them in topological order. Removed ids keep the value
+// 'unassigned'.
+size_t tarjan(const Graph * g, size_t n, std::vector<uint32_t> & component) {
+    uint32_t unassigned = std::numeric_limits<uint32_t>::max();
+    size_t unvisited = std::numeric_limits<size_t>::max();
+    std::vector<size_t> index(n, unvisited);
+    std::vector<size_t> low(n, 0);
+    std::vector<bool> onStack(n, false);
+    std::vector<vertex_id> stk;
+    std::vector<std::pair<vertex_id, const neighbor_entry *>> callStack;
+    size_t counter = 0;
+    size_t count = 0;
+
+    component.assign(n, unassigned);
+
+    for (vertex_id s = 0; s < n; s++) {
+        if (!g->hasVertex(s) || index[s] != unvisited) continue;
+
+        index[s] = low[s] = counter++;
+        stk.push_back(s);
+        onStack[s] = true;
+        callStack.push_back({s, g->neighbors(s).begin()});
+
+        while (!callStack.empty()) {
+            vertex_id u = callStack.back().first;
+            const neighbor_entry * it = callStack.back().second;
+
+            if (it != g->neighbors(u).end()) {
+                callStack.back().second++;
+                vertex_id w = it->id;
+
+                if (index[w] == unvisited) {
+                    index[w] = low[w] = counter++;
+                    stk.push_back(w);
+                    onStack[w] = true;
+                    callStack.push_back({w, g->neighbors(w).begin()});
+                } else if (onStack[w]) {
+                    low[u] = std::min(low[u], index[w]);
+                }
 
-    while (!stk.empty()) {
-        vertex u = stk.top();
-        stk.pop();
+                continue;
+            }
 
-        if (visited.find(u) != visited.end()) 
-            continue;
+            callStack.pop_back();
+            if (!callStack.empty()) {
+                vertex_id parent = callStack.back().first;
+                low[parent] = std::min(low[parent], low[u]);
+            }
+
+            if (low[u] != index[u]) continue;
 
-        dfs.push(u);
-        visited.insert(u);
+            vertex_id w;
+            do {
+                w = stk.back();
+                stk.pop_back();
+                onStack[w] = false;
+                component[w] = count;
+            } while (w != u);
 
-        vertex_set neighbors = g->getNeighbors(u);
-        for (vertex neighbor : neighbors) {
-            stk.push(neighbor);
+            count++;
         }
     }
 
-    while (!dfs.empty()) {
-        L.push_back(dfs.top());
-        dfs.pop();
+    for (uint32_t & c : component) {
+        if (c != unassigned) c = count - 1 - c;
     }
+
+    return count;
 }
 
-std::vector<vertex_set> Graph::stronglyConnectedComponents() {
+std::pair<std::vector<uint32_t>, size_t> Graph::componentIds() const {
     assert(this->ptr->directed);
 
-    if (empty()) return {};
+    std::vector<uint32_t> component;
+    size_t count = tarjan(this, this->ptr->names.size(), component);
 
-    Graph revG = reverse();
-    vertex_set vertices = getVertices();
-    vertex_list L;
-    vertex_set visited;
-    std::vector<vertex_set> components;
+    return std::pair<std::vector<uint32_t>, size_t>(component, count);
+}
 
-    for (vertex v : vertices)
-        dfsHelper(this, v, L);
+std::vector<vertex_set> Graph::stronglyConnectedComponents() const {
+    assert(this->ptr->directed);
 
-    std::unordered_map<vertex, size_t> componentMap;
+    std::vector<uint32_t> component;
+    size_t count = tarjan(this, this->ptr->names.size(), component);
+    std::vector<vertex_set> components(count);
 
-    size_t componentCount = 0;
-    for (auto it = L.rbegin(); it != L.rend(); it++) {
-        vertex u = *it;
-        std::stack<std::pair<vertex, vertex>> stk;
-        stk.push({u, u});
+    for (std::pair<vertex, vertex_id> kvPair : this->ptr->idMap) {
+        components[component[kvPair.second]].insert(kvPair.first);
+    }
 
-        while (!stk.empty()) {
-            std::pair<vertex, vertex> p = stk.top();
-            vertex root = p.first;
-            u = p.second;
-            stk.pop();
+    return components;
+}
 
-            if (componentMap.find(u) != componentMap.end())
-                continue;
+Graph Graph::condensation() const {
+    assert(this->ptr->directed);
 
-            componentMap[u] = (u == root) ? componentCount++ : componentMap[root];
+    std::vector<uint32_t> component;
+    size_t count = tarjan(this, this->ptr->names.size(), component);
+    Graph dag(true, false);
 
-            vertex_set neighbors = revG.getNeighbors(u);
-            for (vertex neighbor : neighbors) {
-                stk.push({root, neighbor});
-            }
-        }
+    for (size_t c = 0; c < count; c++) {
+        dag.addVertex(std::to_string(c));
     }
 
-    components.resize(componentCount);
-    for (vertex v : L) {
-        size_t component = componentMap[v];
-        components[component].insert(v);
+    for (std::pair<vertex, vertex_id> kvPair : this->ptr->idMap) {
+        vertex_id u = kvPair.second;
+
+        NeighborView neighbors = this->neighbors(u);
+        for (neighbor_entry entry : neighbors) {
+            uint32_t a = component[u];
+            uint32_t b = component[entry.id];
+            if (a == b) continue;
+
+            dag.addEdge((vertex_id) a, (vertex_id) b);
+        }
     }
 
-    return components;
+    return dag;
 }
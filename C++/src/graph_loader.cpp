@@ -0,0 +1,265 @@
+#include <chrono>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+#include <assert.h>
+
+#include "graph_loader.h"
+#include "thread_pool.h"
+
+typedef std::string vertex;
+typedef std::tuple<vertex, vertex, float> edge_record;
+
+struct GraphLoader::ClassVars {
+    Format format;
+    size_t threads;
+    size_t chunkBytes;
+    size_t edges;
+    size_t bytes;
+    double seconds;
+};
+
+GraphLoader::GraphLoader(Format format, size_t threads, size_t chunkBytes) {
+    assert(chunkBytes > 0);
+
+    this->ptr = new ClassVars;
+    this->ptr->format = format;
+    this->ptr->threads = threads;
+    this->ptr->chunkBytes = chunkBytes;
+    this->ptr->edges = 0;
+    this->ptr->bytes = 0;
+    this->ptr->seconds = 0;
+}
+
+GraphLoader::GraphLoader(const GraphLoader & other) {
+    this->ptr = new ClassVars(*other.ptr);
+}
+
+GraphLoader & GraphLoader::operator=(const GraphLoader & other) {
+    if (this == &other) return *this;
+
+    this->~GraphLoader();
+
+    this->ptr = new ClassVars(*other.ptr);
+    return *this;
+}
+
+GraphLoader::~GraphLoader() {
+    delete this->ptr;
+}
+
+size_t GraphLoader::edgesLoaded() {
+    return this->ptr->edges;
+}
+
+size_t GraphLoader::bytesRead() {
+    return this->ptr->bytes;
+}
+
+double GraphLoader::seconds() {
+    return this->ptr->seconds;
+}
+
+double GraphLoader::edgesPerSecond() {
+    if (this->ptr->seconds == 0) return 0;
+
+    return this->ptr->edges / this->ptr->seconds;
+}
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Cuts the next whitespace-separated token out of [p, end) without
+// copying it. Returns an empty range once the line is exhausted.
+std::pair<const char *, const char *> nextToken(const char *& p, const char * end) {
+    while (p < end && isBlank(*p)) p++;
+
+    const char * first = p;
+    while (p < end && !isBlank(*p)) p++;
+
+    return std::pair<const char *, const char *>(first, p);
+}
+
+// What one thread parsed out of its share of a chunk. Parsing stops at
+// the first malformed line; 'lines' counts the lines read before it.
+struct parsed_piece {
+    std::vector<edge_record> edges;
+    size_t numVertices;
+    size_t lines;
+    const char * error;
+};
+
+bool parseCount(std::pair<const char *, const char *> token, size_t & count) {
+    std::from_chars_result result = std::from_chars(token.first, token.second, count);
+    return token.first != token.second && result.ec == std::errc() && result.ptr == token.second;
+}
+
+// Parses one line (without its newline) and appends the edge it holds,
+// if any. A DIMACS problem line "p sp n m" sets numVertices to n.
+// Returns why the line is malformed, or NULL.
+const char * parseLine(GraphLoader::Format format, const char * p, const char * end, parsed_piece & piece) {
+    std::pair<const char *, const char *> token = nextToken(p, end);
+    if (token.first == token.second) return NULL;
+
+    char lead = *token.first;
+    bool single = token.second - token.first == 1;
+    if (format == GraphLoader::DIMACS) {
+        if (lead == 'c') return NULL;
+        if (lead == 'p' && single) {
+            size_t numEdges;
+            std::pair<const char *, const char *> problem = nextToken(p, end);
+            if (problem.first == problem.second) return "malformed problem line";
+            if (!parseCount(nextToken(p, end), piece.numVertices)) return "malformed problem line";
+            if (!parseCount(nextToken(p, end), numEdges)) return "malformed problem line";
+            return NULL;
+        }
+
+        if (lead != 'a' || !single) return "expected a 'c', 'p' or 'a' line";
+        token = nextToken(p, end);
+        if (token.first == token.second) return "missing source vertex";
+    } else if (lead == '#' || lead == '%') {
+        return NULL;
+    }
+
+    std::pair<const char *, const char *> target = nextToken(p, end);
+    std::pair<const char *, const char *> weight = nextToken(p, end);
+    if (target.first == target.second) return "missing target vertex";
+
+    float edgeValue = 0;
+    if (weight.first != weight.second) {
+        std::from_chars_result result = std::from_chars(weight.first, weight.second, edgeValue);
+        if (result.ec != std::errc() || result.ptr != weight.second) return "malformed edge weight";
+    }
+
+    piece.edges.push_back(edge_record(
+        vertex(token.first, token.second),
+        vertex(target.first, target.second),
+        edgeValue
+    ));
+
+    return NULL;
+}
+
+void parseRange(GraphLoader::Format format, const char * p, const char * end, parsed_piece & piece) {
+    piece.edges.clear();
+    piece.numVertices = 0;
+    piece.lines = 0;
+    piece.error = NULL;
+
+    while (p < end) {
+        const char * lineEnd = (const char *) memchr(p, '\n', end - p);
+        if (lineEnd == NULL) lineEnd = end;
+
+        piece.error = parseLine(format, p, lineEnd, piece);
+        if (piece.error != NULL) return;
+
+        piece.lines++;
+        p = lineEnd + 1;
+    }
+}
+
+// First position after the newline at or following 'pos', so that split
+// points always fall on line boundaries.
+size_t nextLineStart(const std::vector<char> & buffer, size_t pos, size_t end) {
+    while (pos < end && buffer[pos - 1] != '\n') pos++;
+    return pos;
+}
+
+Graph GraphLoader::load(std::string path, bool directed, bool weighted) {
+    Graph g(directed, weighted);
+    load(path, g);
+
+    return g;
+}
+
+void GraphLoader::load(std::string path, Graph & g) {
+    auto start = std::chrono::steady_clock::now();
+
+    FILE * file = fopen(path.c_str(), "rb");
+    if (file == NULL) throw std::runtime_error("GraphLoader::load: cannot open " + path + ": " + strerror(errno));
+
+    ThreadPool pool(this->ptr->threads);
+    std::vector<parsed_piece> parsed(pool.size());
+    std::vector<char> buffer;
+    size_t chunkBytes = this->ptr->chunkBytes;
+    size_t carry = 0;
+    size_t lines = 0;
+
+    this->ptr->edges = 0;
+    this->ptr->bytes = 0;
+
+    while (true) {
+        buffer.resize(carry + chunkBytes);
+        size_t got = fread(buffer.data() + carry, 1, chunkBytes, file);
+        if (ferror(file)) {
+            fclose(file);
+            throw std::runtime_error("GraphLoader::load: cannot read " + path);
+        }
+
+        size_t length = carry + got;
+        bool eof = got < chunkBytes;
+        this->ptr->bytes += got;
+
+        // only whole lines are parsed; the tail waits for the next chunk
+        size_t end = length;
+        if (!eof) {
+            while (end > 0 && buffer[end - 1] != '\n') end--;
+        }
+
+        if (end == 0 && !eof) {
+            // a single line longer than the chunk: read more of it
+            carry = length;
+            chunkBytes *= 2;
+            continue;
+        }
+
+        size_t pieces = pool.size();
+        std::vector<size_t> bounds(1, 0);
+        for (size_t i = 1; i < pieces; i++) {
+            bounds.push_back(std::max(bounds.back(), nextLineStart(buffer, std::max((size_t) 1, end * i / pieces), end)));
+        }
+        bounds.push_back(end);
+
+        pool.parallelFor(pieces, [&](size_t begin, size_t last, size_t) {
+            for (size_t i = begin; i < last; i++) {
+                parseRange(this->ptr->format, buffer.data() + bounds[i], buffer.data() + bounds[i + 1], parsed[i]);
+            }
+        });
+
+        // pieces are added in file order, so everything before the first
+        // malformed line is in g when it is reported
+        for (parsed_piece & piece : parsed) {
+            // DIMACS vertices are 1..n, including any that no arc touches
+            for (size_t v = 1; v <= piece.numVertices; v++) {
+                g.addVertex(std::to_string(v));
+            }
+
+            g.addEdges(piece.edges);
+            this->ptr->edges += piece.edges.size();
+            piece.edges.clear();
+
+            if (piece.error != NULL) {
+                fclose(file);
+                throw std::runtime_error(
+                    "GraphLoader::load: " + path + ":" + std::to_string(lines + piece.lines + 1) + ": " + piece.error
+                );
+            }
+
+            lines += piece.lines;
+        }
+
+        carry = length - end;
+        memmove(buffer.data(), buffer.data() + end, carry);
+        if (eof) break;
+    }
+
+    fclose(file);
+
+    auto stop = std::chrono::steady_clock::now();
+    this->ptr->seconds = std::chrono::duration<double>(stop - start).count();
+}
@@ -0,0 +1,119 @@
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <algorithm>
+
+#include "thread_pool.h"
+
+struct ThreadPool::ClassVars {
+    size_t size;
+    bool stopping;
+    size_t pending;
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable taskAvailable;
+    std::condition_variable tasksDone;
+};
+
+ThreadPool::ThreadPool(size_t threads) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+
+    this->ptr = new ClassVars;
+    this->ptr->size = threads;
+    this->ptr->stopping = false;
+    this->ptr->pending = 0;
+
+    // the calling thread takes part in parallelFor, so it counts as a worker
+    for (size_t i = 1; i < threads; i++) {
+        this->ptr->workers.push_back(std::thread(&ThreadPool::work, this));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::unique_lock<std::mutex> lock(this->ptr->mutex);
+        this->ptr->stopping = true;
+    }
+
+    this->ptr->taskAvailable.notify_all();
+    for (std::thread & worker : this->ptr->workers) {
+        worker.join();
+    }
+
+    delete this->ptr;
+}
+
+size_t ThreadPool::size() {
+    return this->ptr->size;
+}
+
+void ThreadPool::work() {
+    while (true) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(this->ptr->mutex);
+            this->ptr->taskAvailable.wait(lock, [this] {
+                return this->ptr->stopping || !this->ptr->tasks.empty();
+            });
+
+            if (this->ptr->tasks.empty()) return;
+
+            task = this->ptr->tasks.front();
+            this->ptr->tasks.pop_front();
+        }
+
+        task();
+
+        std::unique_lock<std::mutex> lock(this->ptr->mutex);
+        if (--this->ptr->pending == 0) this->ptr->tasksDone.notify_all();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    if (this->ptr->workers.empty()) {
+        task();
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(this->ptr->mutex);
+        this->ptr->tasks.push_back(task);
+        this->ptr->pending++;
+    }
+
+    this->ptr->taskAvailable.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(this->ptr->mutex);
+    this->ptr->tasksDone.wait(lock, [this] {
+        return this->ptr->pending == 0;
+    });
+}
+
+void ThreadPool::parallelFor(size_t n, std::function<void(size_t, size_t, size_t)> body) {
+    size_t chunks = std::min(size(), n);
+    if (chunks <= 1) {
+        if (n > 0) body(0, n, 0);
+        return;
+    }
+
+    size_t chunkSize = (n + chunks - 1) / chunks;
+    for (size_t worker = 1; worker < chunks; worker++) {
+        size_t begin = worker * chunkSize;
+        size_t end = std::min(n, begin + chunkSize);
+        if (begin >= end) break;
+
+        submit([&body, begin, end, worker] {
+            body(begin, end, worker);
+        });
+    }
+
+    body(0, std::min(n, chunkSize), 0);
+    wait();
+}
@@ -0,0 +1,478 @@
+#include <bits/stdc++.h>
+#include <gtest/gtest.h>
+#include "compact_graph.h"
+
+using namespace std;
+
+bool equalSets(const unordered_set<string> & lhs, const unordered_set<string> & rhs) {
+    if (lhs.size() != rhs.size()) return false;
+
+    for (string elem : lhs) {
+        if (rhs.find(elem) == rhs.end()) return false;
+    }
+
+    return true;
+}
+
+Graph getWeightedGraph() {
+    Graph g(true, true);
+
+    g.addEdge("a", "b", 4);
+    g.addEdge("a", "c", 2);
+
+    g.addEdge("b", "c", 3);
+    g.addEdge("b", "d", 2);
+    g.addEdge("b", "e", 3);
+
+    g.addEdge("c", "b", 1);
+    g.addEdge("c", "d", 4);
+    g.addEdge("c", "e", 5);
+
+    g.addEdge("e", "d", 1);
+
+    return g;
+}
+
+TEST(CompactGraph, LayoutTest) {
+    Graph g = getWeightedGraph();
+    g.addVertex("f");
+    CompactGraph cg(g);
+
+    ASSERT_FALSE(cg.empty());
+    ASSERT_EQ(cg.numVertices(), 6);
+    ASSERT_EQ(cg.numEdges(), 9);
+
+    ASSERT_TRUE(cg.hasVertex("f"));
+    ASSERT_FALSE(cg.hasVertex("g"));
+
+    ASSERT_EQ(cg.getId("a"), 0);
+    ASSERT_EQ(cg.getId("f"), 5);
+    ASSERT_EQ(cg.getVertex(2), "c");
+}
+
+TEST(CompactGraph, DijkstraTest) {
+    Graph g = getWeightedGraph();
+    CompactGraph cg(g);
+
+    const pair<unordered_map<string, float>, unordered_map<string, string>> p = cg.dijkstra("a");
+    const pair<unordered_map<string, float>, unordered_map<string, string>> expected = g.dijkstra("a");
+
+    ASSERT_EQ(p.first, expected.first);
+    ASSERT_EQ(p.second, expected.second);
+}
+
+TEST(CompactGraph, DeltaSteppingTest) {
+    Graph g = getWeightedGraph();
+    CompactGraph cg(g);
+
+    const pair<unordered_map<string, float>, unordered_map<string, string>> expected = cg.dijkstra("a");
+    for (float delta : {0.5f, 2.0f, 100.0f}) {
+        const pair<unordered_map<string, float>, unordered_map<string, string>> p = cg.deltaStepping("a", delta, 2);
+
+        ASSERT_EQ(p.first, expected.first);
+        ASSERT_EQ(p.second, expected.second);
+    }
+}
+
+TEST(CompactGraph, DeltaSteppingLongPathTest) {
+    Graph g(true, true);
+    for (int i = 0; i < 20; i++) {
+        g.addEdge(to_string(i), to_string(i + 1), 10000);
+    }
+    CompactGraph cg(g);
+
+    // the far end sits 200000 buckets out, but only the buckets
+    // one edge weight ahead are ever live
+    const pair<unordered_map<string, float>, unordered_map<string, string>> p = cg.deltaStepping("0", 1, 2);
+    ASSERT_EQ(p.first.at("20"), 200000);
+    ASSERT_EQ(p.second.at("20"), "19");
+}
+
+TEST(CompactGraph, BellmanFordTest) {
+    Graph g(true, true);
+
+    g.addEdge("s", "e", 8);
+    g.addEdge("s", "a", 10);
+    g.addEdge("e", "d", 1);
+    g.addEdge("d", "a", -4);
+    g.addEdge("d", "c", -1);
+    g.addEdge("c", "b", -2);
+    g.addEdge("b", "a", 1);
+    g.addEdge("a", "c", 2);
+
+    CompactGraph cg(g);
+    const pair<unordered_map<string, float>, unordered_map<string, string>> p = cg.bellmanFord("s");
+    unordered_map<string, float> dist = p.first;
+    unordered_map<string, string> prev = p.second;
+
+    ASSERT_EQ(dist["s"], 0);
+    ASSERT_EQ(dist["a"], 5);
+    ASSERT_EQ(dist["b"], 5);
+    ASSERT_EQ(dist["c"], 7);
+    ASSERT_EQ(dist["d"], 9);
+    ASSERT_EQ(dist["e"], 8);
+
+    ASSERT_TRUE(prev.find("s") == prev.end());
+    ASSERT_EQ(prev["a"], "d");
+    ASSERT_EQ(prev["c"], "a");
+
+    ASSERT_EQ(cg.bellmanFord("s", 2).first, dist);
+}
+
+TEST(CompactGraph, TraversalTest) {
+    Graph g(true, false);
+
+    g.addEdge("0", "1");
+    g.addEdge("0", "2");
+    g.addEdge("1", "4");
+    g.addEdge("4", "5");
+    g.addEdge("5", "6");
+    g.addEdge("6", "5");
+
+    CompactGraph cg(g);
+
+    const vector<string> bfs = cg.bfs("0");
+    const vector<string> actualBFS = {"0", "1", "2", "4", "5", "6"};
+    ASSERT_EQ(bfs, actualBFS);
+
+    const vector<string> dfs = cg.dfs("0");
+    const vector<string> actualDFS = {"0", "2", "1", "4", "5", "6"};
+    ASSERT_EQ(dfs, actualDFS);
+}
+
+Graph getRandomGraph(bool directed, size_t n, size_t m, unsigned seed) {
+    Graph g(directed, true);
+    mt19937 rng(seed);
+
+    for (size_t i = 0; i < n; i++) {
+        g.addVertex(to_string(i));
+    }
+
+    for (size_t i = 0; i < m; i++) {
+        g.addEdge(to_string(rng() % n), to_string(rng() % n), rng() % 100);
+    }
+
+    return g;
+}
+
+TEST(CompactGraph, parallelBfsTest) {
+    Graph g(true, false);
+
+    g.addEdge("0", "1");
+    g.addEdge("0", "2");
+    g.addEdge("1", "4");
+    g.addEdge("4", "5");
+    g.addEdge("5", "6");
+    g.addEdge("6", "5");
+    g.addVertex("7");
+
+    CompactGraph cg(g);
+    const pair<vector<string>, vector<int>> p = cg.parallelBfs("0", 2);
+
+    const vector<string> actualOrder = {"0", "1", "2", "4", "5", "6"};
+    const vector<int> actualDepth = {0, 1, 1, 2, 3, 4, -1};
+    vector<int> depth;
+    for (string v : {"0", "1", "2", "4", "5", "6", "7"}) {
+        depth.push_back(p.second[cg.getId(v)]);
+    }
+
+    ASSERT_EQ(p.first, actualOrder);
+    ASSERT_EQ(depth, actualDepth);
+}
+
+TEST(CompactGraph, parallelBfsRandomTest) {
+    for (bool directed : {true, false}) {
+        Graph g = getRandomGraph(directed, 2000, 20000, 7);
+        CompactGraph cg(g);
+
+        const vector<string> bfs = cg.bfs("0");
+        unordered_map<string, int> levels;
+        levels["0"] = 0;
+        for (string u : bfs) {
+            for (string v : g.getNeighbors(u)) {
+                if (levels.find(v) == levels.end()) levels[v] = levels[u] + 1;
+            }
+        }
+
+        for (size_t threads : {1, 4}) {
+            const pair<vector<string>, vector<int>> p = cg.parallelBfs("0", threads);
+            ASSERT_EQ(p.first.size(), bfs.size());
+
+            for (size_t i = 0; i < p.first.size(); i++) {
+                ASSERT_EQ(p.second[cg.getId(p.first[i])], levels[p.first[i]]);
+                if (i == 0) continue;
+
+                ASSERT_LE(levels[p.first[i - 1]], levels[p.first[i]]);
+            }
+        }
+    }
+}
+
+TEST(CompactGraph, DeltaSteppingRandomTest) {
+    for (bool directed : {true, false}) {
+        Graph g = getRandomGraph(directed, 2000, 20000, 11);
+        g.addVertex("unreachable");
+        CompactGraph cg(g);
+
+        const pair<unordered_map<string, float>, unordered_map<string, string>> expected = cg.dijkstra("0");
+        for (size_t threads : {1, 4}) {
+            const pair<unordered_map<string, float>, unordered_map<string, string>> p = cg.deltaStepping("0", 10, threads);
+            ASSERT_EQ(p.first, expected.first);
+
+            unordered_map<string, string> prev = p.second;
+            ASSERT_EQ(prev.size(), expected.second.size());
+            for (auto kvPair : prev) {
+                string u = kvPair.second;
+                string v = kvPair.first;
+                ASSERT_EQ(p.first.at(u) + g.getEdgeValue(u, v), p.first.at(v));
+            }
+        }
+    }
+}
+
+TEST(CompactGraph, parallelBellmanFordTest) {
+    for (bool directed : {true, false}) {
+        Graph g(directed, true);
+        mt19937 rng(23);
+        const int n = 2000;
+
+        // undirected edges must stay non-negative, directed ones may be
+        // negative as long as no cycle is
+        vector<int> potential(n, 0);
+        for (int i = 0; i < n; i++) {
+            g.addVertex(to_string(i));
+            if (directed) potential[i] = rng() % 50;
+        }
+
+        for (int i = 0; i < 20000; i++) {
+            int u = rng() % n;
+            int v = rng() % n;
+            g.addEdge(to_string(u), to_string(v), (int) (rng() % 100) + potential[u] - potential[v]);
+        }
+        g.addVertex("unreachable");
+
+        CompactGraph cg(g);
+        const pair<unordered_map<string, float>, unordered_map<string, string>> expected = g.bellmanFord("0");
+        for (size_t threads : {1, 2, 4}) {
+            const pair<unordered_map<string, float>, unordered_map<string, string>> p = cg.bellmanFord("0", threads);
+            ASSERT_EQ(p.first, expected.first);
+
+            unordered_map<string, string> prev = p.second;
+            ASSERT_EQ(prev.size(), expected.second.size());
+            for (auto kvPair : prev) {
+                string u = kvPair.second;
+                string v = kvPair.first;
+                ASSERT_EQ(p.first.at(u) + g.getEdgeValue(u, v), p.first.at(v));
+            }
+        }
+    }
+}
+
+TEST(CompactGraph, mstTest) {
+    Graph g(false, true);
+
+    g.addEdge("a", "b", 2);
+    g.addEdge("a", "c", 3);
+    g.addEdge("a", "d", 3);
+    g.addEdge("b", "c", 4);
+    g.addEdge("b", "e", 3);
+    g.addEdge("c", "d", 5);
+    g.addEdge("c", "f", 6);
+    g.addEdge("c", "e", 1);
+    g.addEdge("d", "f", 7);
+    g.addEdge("f", "e", 8);
+    g.addEdge("f", "g", 9);
+
+    g.addEdge("x", "y", 1);
+
+    CompactGraph cg(g);
+    vector<pair<string, string>> tree = cg.mst();
+    vector<pair<string, string>> actualTree = {
+        {"a", "b"},
+        {"a", "c"},
+        {"c", "e"},
+        {"a", "d"},
+        {"c", "f"},
+        {"f", "g"},
+        {"x", "y"}
+    };
+
+    sort(tree.begin(), tree.end());
+    sort(actualTree.begin(), actualTree.end());
+    ASSERT_EQ(tree, actualTree);
+}
+
+TEST(CompactGraph, topologicalSortTest) {
+    Graph g(true, false);
+
+    g.addEdge("1", "2");
+    g.addEdge("1", "3");
+    g.addEdge("2", "3");
+    g.addEdge("2", "4");
+    g.addEdge("3", "4");
+    g.addEdge("3", "5");
+
+    const vector<string> tps = CompactGraph(g).topologicalSort();
+    ASSERT_EQ(tps.size(), 5);
+
+    unordered_map<string, int> position;
+    for (int i = 0; i < 5; i++) {
+        position[tps[i]] = i;
+    }
+
+    for (auto kvPair : g.getEdges()) {
+        for (string v : kvPair.second) {
+            ASSERT_LT(position[kvPair.first], position[v]);
+        }
+    }
+
+    g.addEdge("5", "1");
+    ASSERT_EQ(CompactGraph(g).topologicalSort().size(), 0);
+}
+
+TEST(CompactGraph, stronglyConnectedComponentsTest) {
+    Graph g(true, false);
+
+    g.addEdge("0", "2");
+    g.addEdge("2", "1");
+    g.addEdge("1", "0");
+    g.addEdge("0", "3");
+    g.addEdge("3", "4");
+
+    CompactGraph cg(g);
+    const vector<unordered_set<string>> actualSCC = {{"0", "1", "2"}, {"3"}, {"4"}};
+
+    for (int it = 0; it < 2; it++) {
+        const vector<unordered_set<string>> scc = cg.stronglyConnectedComponents();
+        ASSERT_EQ(scc.size(), actualSCC.size());
+
+        for (const unordered_set<string> & component : scc) {
+            bool found = false;
+
+            for (const unordered_set<string> & actual : actualSCC) {
+                if (!equalSets(component, actual)) continue;
+
+                found = true;
+                break;
+            }
+
+            ASSERT_TRUE(found);
+        }
+    }
+}
+
+TEST(CompactGraph, CtorTests) {
+    Graph g = getWeightedGraph();
+    CompactGraph cg(g);
+    CompactGraph cgCopy(cg);
+
+    ASSERT_EQ(cgCopy.numVertices(), cg.numVertices());
+    ASSERT_EQ(cgCopy.numEdges(), cg.numEdges());
+
+    Graph h(true, false);
+    CompactGraph cgAssigned(h);
+    ASSERT_TRUE(cgAssigned.empty());
+
+    cgAssigned = cg;
+    ASSERT_EQ(cgAssigned.numEdges(), cg.numEdges());
+    ASSERT_EQ(cgAssigned.dijkstra("a").first, cg.dijkstra("a").first);
+}
+
+TEST(CompactGraph, saveLoadTest) {
+    string path = testing::TempDir() + "compact_graph_test.bin";
+
+    for (bool directed : {true, false}) {
+        Graph g = getRandomGraph(directed, 500, 3000, 41);
+        g.addVertex("a much longer vertex name than the rest");
+        CompactGraph cg(g);
+        g.save(path);
+
+        CompactGraph loaded = CompactGraph::load(path);
+        ASSERT_EQ(loaded.numVertices(), cg.numVertices());
+        ASSERT_EQ(loaded.numEdges(), cg.numEdges());
+        ASSERT_TRUE(loaded.hasVertex("a much longer vertex name than the rest"));
+        ASSERT_FALSE(loaded.hasVertex("500"));
+
+        for (uint32_t id = 0; id < cg.numVertices(); id++) {
+            ASSERT_EQ(loaded.getVertex(id), cg.getVertex(id));
+            ASSERT_EQ(loaded.getId(cg.getVertex(id)), id);
+        }
+
+        ASSERT_EQ(loaded.bfs("0"), cg.bfs("0"));
+        ASSERT_EQ(loaded.dijkstra("0"), cg.dijkstra("0"));
+        ASSERT_EQ(loaded.mst().size(), cg.mst().size());
+        if (directed) {
+            ASSERT_EQ(loaded.stronglyConnectedComponents().size(), cg.stronglyConnectedComponents().size());
+        }
+
+        // a copy owns its image and outlives the mapping
+        CompactGraph copy(loaded);
+        loaded = CompactGraph(Graph(true, false));
+        ASSERT_TRUE(loaded.empty());
+        ASSERT_EQ(copy.dijkstra("0"), cg.dijkstra("0"));
+
+        copy.save(path);
+        ASSERT_EQ(CompactGraph::load(path).bfs("0"), cg.bfs("0"));
+    }
+
+    Graph empty(false, false);
+    empty.save(path);
+    ASSERT_TRUE(CompactGraph::load(path).empty());
+
+    remove(path.c_str());
+}
+
+TEST(CompactGraph, loadErrorTest) {
+    string path = testing::TempDir() + "compact_graph_bad.bin";
+    remove(path.c_str());
+    ASSERT_THROW(CompactGraph::load(path), runtime_error);
+
+    Graph g = getRandomGraph(true, 100, 500, 43);
+    g.save(path);
+    string image;
+    {
+        ifstream in(path, ios::binary);
+        image.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    }
+
+    auto loadBytes = [&](const string & bytes) {
+        ofstream(path, ios::binary | ios::trunc).write(bytes.data(), bytes.size());
+        CompactGraph::load(path);
+    };
+
+    ASSERT_THROW(loadBytes(""), runtime_error);
+    ASSERT_THROW(loadBytes(image.substr(0, 20)), runtime_error);
+    ASSERT_THROW(loadBytes(image.substr(0, image.size() - 8)), runtime_error);
+
+    // bad magic, bad version, and a vertex count far past the file
+    for (size_t at : {0, 4, 16}) {
+        string corrupt = image;
+        corrupt[at + 3] ^= 0x40;
+        ASSERT_THROW(loadBytes(corrupt), runtime_error);
+    }
+
+    // a valid header over sections that point out of bounds
+    // (header: four uint32 fields, then vertex, edge and name byte counts)
+    uint64_t n, nameBytes;
+    memcpy(&n, image.data() + 16, sizeof(n));
+    memcpy(&nameBytes, image.data() + 32, sizeof(nameBytes));
+    size_t nameOffsets = 40;
+    size_t offsets = nameOffsets + (n + 1) * sizeof(uint64_t) + ((nameBytes + 7) & ~7);
+    size_t targets = offsets + (n + 1) * sizeof(uint64_t);
+
+    for (size_t at : {nameOffsets + n * sizeof(uint64_t), offsets + sizeof(uint64_t), targets}) {
+        string corrupt = image;
+        corrupt[at + 2] ^= 0x10;
+        ASSERT_THROW(loadBytes(corrupt), runtime_error);
+    }
+
+    loadBytes(image);
+    remove(path.c_str());
+
+    ASSERT_THROW(g.save(testing::TempDir() + "missing/dir/graph.bin"), runtime_error);
+}
+
+int main(int argc, char ** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,45 @@
+#include <bits/stdc++.h>
+#include <gtest/gtest.h>
+#include "dary_heap.h"
+
+using namespace std;
+
+// The shared cases are in heap_common_test.cpp.
+
+template <size_t Arity>
+vector<int> heapSort(const vector<int> & keys) {
+	BasicDaryHeap<int, int, greater<int>, hash<int>, Arity> heap;
+	for (size_t i = 0; i < keys.size(); i++) {
+		heap.push(i, keys[i]);
+	}
+
+	// erasing from the middle moves the last entry into the hole
+	heap.erase(0);
+
+	vector<int> order;
+	while (!heap.empty()) {
+		order.push_back(keys[heap.top()]);
+		heap.pop();
+	}
+
+	return order;
+}
+
+TEST(DaryHeap, ArityTest) {
+	vector<int> keys;
+	mt19937 rng(7);
+	for (int i = 0; i < 1000; i++) {
+		keys.push_back(rng() % 100);
+	}
+
+	vector<int> expected(keys.begin() + 1, keys.end());
+	sort(expected.begin(), expected.end(), greater<int>());
+	ASSERT_EQ(heapSort<2>(keys), expected);
+	ASSERT_EQ(heapSort<3>(keys), expected);
+	ASSERT_EQ(heapSort<8>(keys), expected);
+}
+
+int main(int argc, char ** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
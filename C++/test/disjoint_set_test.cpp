@@ -101,6 +101,26 @@ TEST(DisjointSet, unionFindTest) {
     ASSERT_EQ(dset.find("d"), "a");
 }
 
+TEST(DisjointSet, denseUnionFindTest) {
+    DisjointSet dset(5);
+    ASSERT_EQ(dset.size(), 5);
+    ASSERT_TRUE(dset.contains((size_t) 4));
+    ASSERT_FALSE(dset.contains((size_t) 5));
+
+    dset.setUnion(0, 1);
+    dset.setUnion(2, 3);
+    dset.setUnion(1, 3);
+
+    ASSERT_EQ(dset.find(0), dset.find(3));
+    ASSERT_EQ(dset.find(1), dset.find(2));
+    ASSERT_NE(dset.find(0), dset.find(4));
+
+    DisjointSet dsetClone(dset);
+    dsetClone.setUnion(4, 0);
+    ASSERT_EQ(dsetClone.find(4), dsetClone.find(2));
+    ASSERT_NE(dset.find(4), dset.find(2));
+}
+
 TEST(DisjointSet, CopyConstructorTest) {
     DisjointSet dset;
     ASSERT_TRUE(dset.empty());
@@ -100,6 +100,197 @@ TEST(FibHeap, CtorTests) {
 	ASSERT_EQ(minHeapCopyCopy.size(), minHeapCopy.size());
 }
 
+TEST(FibHeap, ReserveClearTest) {
+	FibonacciHeap heap;
+	heap.reserve(5000);
+	mt19937 rng(47);
+
+	for (int round = 0; round < 3; round++) {
+		unordered_map<string, float> keys;
+		for (int i = 0; i < 3000; i++) {
+			keys[to_string(i)] = rng() % 10000;
+			heap.push(to_string(i), keys[to_string(i)]);
+		}
+
+		// popped nodes are recycled by the pushes that follow
+		for (int i = 0; i < 1000; i++) {
+			keys.erase(heap.top());
+			heap.pop();
+		}
+		for (int i = 3000; i < 4000; i++) {
+			keys[to_string(i)] = rng() % 10000;
+			heap.push(to_string(i), keys[to_string(i)]);
+		}
+		ASSERT_EQ(heap.size(), 3000);
+
+		if (round == 1) {
+			heap.clear();
+			ASSERT_TRUE(heap.empty());
+			ASSERT_FALSE(heap.contains("0"));
+			continue;
+		}
+
+		float last = -1;
+		while (!heap.empty()) {
+			ASSERT_GE(keys[heap.top()], last);
+			last = keys[heap.top()];
+			heap.pop();
+		}
+		heap.clear();
+	}
+
+	heap.push("a", 1);
+	heap.push("b", 0);
+	ASSERT_EQ(heap.top(), "b");
+	ASSERT_EQ(heap.size(), 2);
+}
+
+TEST(FibHeap, InterleavedTest) {
+	FibonacciHeap heap;
+	multiset<float> expected;
+	unordered_map<string, float> keys;
+	mt19937 rng(13);
+	int next = 0;
+
+	for (int step = 0; step < 20000; step++) {
+		int op = rng() % 4;
+		if (op < 2 || heap.empty()) {
+			string elem = to_string(next++);
+			keys[elem] = rng() % 100000;
+			expected.insert(keys[elem]);
+			heap.push(elem, keys[elem]);
+		} else if (op == 2) {
+			string elem = to_string(rng() % next);
+			if (!heap.contains(elem)) continue;
+			float key = keys[elem] - rng() % 1000;
+			expected.erase(expected.find(keys[elem]));
+			expected.insert(key);
+			keys[elem] = key;
+			heap.decreaseKey(elem, key);
+		} else {
+			ASSERT_EQ(keys[heap.top()], *expected.begin());
+			expected.erase(expected.begin());
+			heap.pop();
+		}
+		ASSERT_EQ(heap.size(), expected.size());
+	}
+}
+
+TEST(FibHeap, TemplateTest) {
+	BasicFibonacciHeap<uint32_t, double> minHeap;
+	BasicFibonacciHeap<int, int64_t, greater<int64_t>> maxHeap;
+	for (int i = 0; i < 100; i++) {
+		minHeap.push(i, (i * 37) % 100 + 0.5);
+		maxHeap.push(i, (int64_t) i << 40);
+	}
+
+	ASSERT_EQ(minHeap.top(), 0);
+	ASSERT_EQ(maxHeap.top(), 99);
+
+	minHeap.decreaseKey(50, -1.0);
+	maxHeap.decreaseKey(3, (int64_t) 1 << 50);
+	ASSERT_EQ(minHeap.top(), 50);
+	ASSERT_EQ(maxHeap.top(), 3);
+
+	maxHeap.pop();
+	ASSERT_EQ(maxHeap.top(), 99);
+	ASSERT_FALSE(maxHeap.contains(3));
+
+	BasicFibonacciHeap<uint32_t, double> copy(minHeap);
+	minHeap.pop();
+	ASSERT_EQ(copy.top(), 50);
+	ASSERT_EQ(minHeap.size(), copy.size() - 1);
+
+	double last = -2;
+	while (!copy.empty()) {
+		uint32_t id = copy.top();
+		double key = id == 50 ? -1.0 : (id * 37) % 100 + 0.5;
+		ASSERT_GE(key, last);
+		last = key;
+		copy.pop();
+	}
+}
+
+TEST(FibHeap, HandleTest) {
+	typedef BasicFibonacciHeap<uint32_t, int, less<int>, heap_dense_index> DenseHeap;
+	DenseHeap heap;
+	vector<DenseHeap::handle> handles;
+	vector<int> keys;
+	for (uint32_t i = 0; i < 200; i++) {
+		keys.push_back((i * 71) % 200);
+		handles.push_back(heap.push(i, keys[i]));
+	}
+
+	// consolidate so the handles below point into trees, not just roots
+	heap.pop();
+	keys[0] = -1;
+	ASSERT_FALSE(heap.contains(0));
+
+	for (uint32_t i = 1; i < 200; i += 3) {
+		keys[i] -= 500;
+		heap.decreaseKey(handles[i], keys[i]);
+		ASSERT_EQ(heap.key(handles[i]), keys[i]);
+	}
+	for (uint32_t i = 2; i < 200; i += 5) {
+		heap.erase(handles[i]);
+		keys[i] = -1;
+		ASSERT_FALSE(heap.contains(i));
+	}
+	heap.erase(4);
+	keys[4] = -1;
+
+	multiset<int> expected;
+	for (uint32_t i = 1; i < 200; i++) {
+		if (keys[i] != -1) expected.insert(keys[i]);
+	}
+	ASSERT_EQ(heap.size(), expected.size());
+
+	while (!heap.empty()) {
+		ASSERT_EQ(keys[heap.top()], *expected.begin());
+		expected.erase(expected.begin());
+		heap.pop();
+	}
+
+	FibonacciHeap strings;
+	strings.push("a", 3);
+	FibonacciHeap::handle b = strings.push("b", 4);
+	strings.push("c", 5);
+	strings.erase("a");
+	strings.decreaseKey(b, 1);
+	ASSERT_EQ(strings.key(b), 1);
+	ASSERT_EQ(strings.top(), "b");
+	ASSERT_EQ(strings.size(), 2);
+}
+
+TEST(FibHeap, DuplicateKeyTest) {
+	BasicFibonacciHeap<uint32_t, int, less<int>, heap_dense_index> heap;
+	multiset<int> expected;
+	vector<int> keys;
+	mt19937 rng(29);
+
+	// few distinct keys, so most comparisons and decreases are ties
+	for (int step = 0; step < 50000; step++) {
+		int op = rng() % 4;
+		if (op < 2 || heap.empty()) {
+			keys.push_back(rng() % 20);
+			expected.insert(keys.back());
+			heap.push(keys.size() - 1, keys.back());
+		} else if (op == 2) {
+			uint32_t elem = rng() % keys.size();
+			if (!heap.contains(elem)) continue;
+			int key = keys[elem] - rng() % 3;
+			expected.erase(expected.find(keys[elem]));
+			expected.insert(key);
+			keys[elem] = key;
+			heap.decreaseKey(elem, key);
+		} else {
+			ASSERT_EQ(keys[heap.top()], *expected.begin());
+			expected.erase(expected.begin());
+			heap.pop();
+		}
+	}
+}
+
 int main(int argc, char ** argv) {
 	testing::InitGoogleTest(&argc, argv);
 	return RUN_ALL_TESTS();
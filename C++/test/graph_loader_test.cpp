@@ -0,0 +1,158 @@
+#include <bits/stdc++.h>
+#include <gtest/gtest.h>
+#include "graph_loader.h"
+
+using namespace std;
+
+string writeFile(const string & name, const string & contents) {
+    string path = testing::TempDir() + name;
+    ofstream out(path, ios::binary);
+    out << contents;
+
+    return path;
+}
+
+TEST(GraphLoader, EdgeListTest) {
+    string path = writeFile("edge_list.txt",
+        "# a comment\n"
+        "a b 1.5\n"
+        "\n"
+        "b\tc  2\r\n"
+        "% another comment\n"
+        "c a -3\n"
+        "a b 4"
+    );
+
+    for (size_t threads : {1, 3}) {
+        GraphLoader loader(GraphLoader::EDGE_LIST, threads);
+        Graph g = loader.load(path, true, true);
+
+        ASSERT_EQ(loader.edgesLoaded(), 4);
+        ASSERT_EQ(g.getVertices().size(), 3);
+        ASSERT_EQ(g.getEdgeValue("a", "b"), 4);
+        ASSERT_EQ(g.getEdgeValue("b", "c"), 2);
+        ASSERT_EQ(g.getEdgeValue("c", "a"), -3);
+        ASSERT_FALSE(g.isAdjacent("b", "a"));
+    }
+
+    remove(path.c_str());
+}
+
+TEST(GraphLoader, DimacsTest) {
+    const string contents =
+        "c 9th DIMACS challenge\n"
+        "p sp 4 3\n"
+        "a 1 2 7\n"
+        "a 2 3 1\n"
+        "c trailing comment\n"
+        "a 3 1 2\n";
+    string path = writeFile("graph.gr", contents);
+
+    GraphLoader loader(GraphLoader::DIMACS);
+    Graph g = loader.load(path, true, true);
+
+    ASSERT_EQ(loader.edgesLoaded(), 3);
+    ASSERT_EQ(loader.bytesRead(), contents.size());
+    ASSERT_EQ(g.dijkstra("1").first.at("3"), 8);
+
+    // vertex 4 is declared but has no arcs
+    ASSERT_EQ(g.getVertices().size(), 4);
+    ASSERT_EQ(g.getId("1"), 0);
+    ASSERT_TRUE(g.hasVertex("4"));
+
+    remove(path.c_str());
+}
+
+TEST(GraphLoader, ChunkedTest) {
+    mt19937 rng(43);
+    Graph expected(false, true);
+    string contents = "# SNAP style header\n# Nodes: 1000 Edges: 3000\n";
+
+    for (int i = 0; i < 3000; i++) {
+        string u = to_string(rng() % 1000);
+        string v = to_string(rng() % 1000);
+        float w = rng() % 100;
+
+        expected.addEdge(u, v, w);
+        contents += u + "\t" + v + "\t" + to_string((int) w) + "\n";
+    }
+
+    // a line longer than the smallest chunk forces the buffer to grow
+    contents += string(40, '9') + " 0 1\n";
+    expected.addEdge(string(40, '9'), "0", 1);
+    string path = writeFile("snap.txt", contents);
+
+    for (size_t chunkBytes : {16, 1000, 1 << 20}) {
+        for (size_t threads : {1, 4}) {
+            GraphLoader loader(GraphLoader::SNAP, threads, chunkBytes);
+            Graph g(false, true);
+            loader.load(path, g);
+
+            ASSERT_EQ(loader.edgesLoaded(), 3001);
+            ASSERT_EQ(loader.bytesRead(), contents.size());
+            ASSERT_GT(loader.edgesPerSecond(), 0);
+            ASSERT_EQ(g.getEdges(), expected.getEdges());
+
+            expected.forEachEdge([&](const string & u, const string & v, float w) {
+                ASSERT_EQ(g.getEdgeValue(u, v), w);
+            });
+        }
+    }
+
+    remove(path.c_str());
+}
+
+// Loads 'contents' and returns the error message, or "" if it loaded.
+string loadError(GraphLoader::Format format, const string & contents, size_t threads = 1, size_t chunkBytes = 1 << 20) {
+    string path = writeFile("malformed.txt", contents);
+    string error;
+
+    try {
+        GraphLoader(format, threads, chunkBytes).load(path, true, true);
+    } catch (const runtime_error & e) {
+        error = e.what();
+    }
+
+    remove(path.c_str());
+    return error;
+}
+
+TEST(GraphLoader, ErrorTest) {
+    GraphLoader loader(GraphLoader::EDGE_LIST);
+    ASSERT_THROW(loader.load(testing::TempDir() + "no_such_file.txt", true, true), runtime_error);
+
+    string contents;
+    for (int i = 0; i < 50; i++) {
+        contents += to_string(i) + " " + to_string(i + 1) + " 1\n";
+    }
+    contents += "50 51 1.5x\n51 52 1\n";
+
+    // the line number holds across chunks and thread splits
+    for (size_t chunkBytes : {16, 1 << 20}) {
+        for (size_t threads : {1, 3}) {
+            string error = loadError(GraphLoader::EDGE_LIST, contents, threads, chunkBytes);
+            ASSERT_NE(error.find("malformed.txt:51: malformed edge weight"), string::npos) << error;
+        }
+    }
+
+    ASSERT_NE(loadError(GraphLoader::EDGE_LIST, "a b\nc\n").find(":2: missing target vertex"), string::npos);
+    ASSERT_NE(loadError(GraphLoader::DIMACS, "c x\nx 1 2 3\n").find(":2: expected"), string::npos);
+    ASSERT_NE(loadError(GraphLoader::DIMACS, "p sp 3\n").find(":1: malformed problem line"), string::npos);
+    ASSERT_NE(loadError(GraphLoader::DIMACS, "p sp 3 1\na 1\n").find(":2: missing target vertex"), string::npos);
+    ASSERT_EQ(loadError(GraphLoader::DIMACS, "p sp 3 1\na 1 2 5\n"), "");
+}
+
+TEST(GraphLoader, CopyTest) {
+    GraphLoader loader(GraphLoader::DIMACS);
+    GraphLoader copy(loader);
+    ASSERT_EQ(copy.edgesLoaded(), 0);
+
+    GraphLoader assigned(GraphLoader::EDGE_LIST);
+    assigned = copy;
+    ASSERT_EQ(assigned.seconds(), 0);
+}
+
+int main(int argc, char ** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
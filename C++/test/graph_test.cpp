@@ -1,6 +1,7 @@
 #include <bits/stdc++.h>
 #include <gtest/gtest.h>
 #include "graph.h"
+#include "disjoint_set.h"
 
 using namespace std;
 
@@ -57,6 +58,121 @@ TEST(Graph, DijkstraTest) {
     ASSERT_EQ(prev["e"], "b");
 }
 
+float pathCost(Graph & g, const vector<string> & path) {
+    float cost = 0;
+    for (size_t i = 1; i < path.size(); i++) {
+        cost += g.getEdgeValue(path[i - 1], path[i]);
+    }
+
+    return cost;
+}
+
+TEST(Graph, shortestPathTest) {
+    Graph g(true, true, true);
+
+    g.addEdge("a", "b", 4);
+    g.addEdge("a", "c", 2);
+    g.addEdge("b", "c", 3);
+    g.addEdge("b", "d", 2);
+    g.addEdge("b", "e", 3);
+    g.addEdge("c", "b", 1);
+    g.addEdge("c", "d", 4);
+    g.addEdge("c", "e", 5);
+    g.addEdge("e", "d", 1);
+    g.addVertex("f");
+
+    const vector<string> actualPath = {"a", "c", "b", "d"};
+
+    pair<vector<string>, float> p = g.shortestPath("a", "d");
+    ASSERT_EQ(p.first, actualPath);
+    ASSERT_EQ(p.second, 5);
+
+    p = g.bidirectionalShortestPath("a", "d");
+    ASSERT_EQ(p.first, actualPath);
+    ASSERT_EQ(p.second, 5);
+
+    p = g.shortestPath("a", "a");
+    ASSERT_EQ(p.first, vector<string>({"a"}));
+    ASSERT_EQ(p.second, 0);
+
+    p = g.bidirectionalShortestPath("a", "f");
+    ASSERT_TRUE(p.first.empty());
+    ASSERT_EQ(p.second, numeric_limits<float>::max());
+
+    p = g.shortestPath("d", "a");
+    ASSERT_TRUE(p.first.empty());
+}
+
+TEST(Graph, shortestPathRandomTest) {
+    mt19937 rng(3);
+
+    for (bool directed : {true, false}) {
+        Graph g(directed, true, true);
+        for (int i = 0; i < 300; i++) {
+            g.addVertex(to_string(i));
+        }
+
+        for (int i = 0; i < 1500; i++) {
+            g.addEdge(to_string(rng() % 300), to_string(rng() % 300), rng() % 20);
+        }
+
+        unordered_map<string, float> dist = g.dijkstra("0").first;
+        for (int i = 0; i < 300; i += 7) {
+            string target = to_string(i);
+
+            const pair<vector<string>, float> p = g.shortestPath("0", target);
+            const pair<vector<string>, float> q = g.bidirectionalShortestPath("0", target);
+            ASSERT_EQ(p.second, dist[target]);
+            ASSERT_EQ(q.second, dist[target]);
+
+            if (dist[target] == numeric_limits<float>::max()) continue;
+
+            ASSERT_EQ(pathCost(g, p.first), p.second);
+            ASSERT_EQ(pathCost(g, q.first), q.second);
+            ASSERT_EQ(q.first.front(), "0");
+            ASSERT_EQ(q.first.back(), target);
+        }
+    }
+}
+
+TEST(Graph, aStarTest) {
+    const int side = 20;
+    Graph g(false, true);
+    mt19937 rng(5);
+
+    // grid whose edge weights are at least the Manhattan step length
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            string v = to_string(r) + "," + to_string(c);
+            if (c + 1 < side) g.addEdge(v, to_string(r) + "," + to_string(c + 1), 1 + rng() % 3);
+            if (r + 1 < side) g.addEdge(v, to_string(r + 1) + "," + to_string(c), 1 + rng() % 3);
+        }
+    }
+
+    string target = to_string(side - 1) + "," + to_string(side / 2);
+    function<float(const string &)> manhattan = [&target](const string & v) {
+        int r = stoi(v.substr(0, v.find(',')));
+        int c = stoi(v.substr(v.find(',') + 1));
+        int tr = stoi(target.substr(0, target.find(',')));
+        int tc = stoi(target.substr(target.find(',') + 1));
+
+        return (float) (abs(r - tr) + abs(c - tc));
+    };
+
+    unordered_map<string, float> dist = g.dijkstra("0,0").first;
+    const pair<vector<string>, float> p = g.aStar("0,0", target, manhattan);
+    ASSERT_EQ(p.second, dist[target]);
+    ASSERT_EQ(pathCost(g, p.first), p.second);
+    ASSERT_EQ(p.first.front(), "0,0");
+    ASSERT_EQ(p.first.back(), target);
+
+    const pair<vector<string>, float> q = g.aStar("0,0", target, [](const string &) { return 0.0f; });
+    ASSERT_EQ(q.second, dist[target]);
+
+    g.addVertex("island");
+    ASSERT_TRUE(g.aStar("0,0", "island", manhattan).first.empty());
+}
+
 TEST(Graph, BellmanFordTest) {
     Graph g(true, true);
 
@@ -93,6 +209,86 @@ TEST(Graph, BellmanFordTest) {
     ASSERT_EQ(prev["e"], "s");
 }
 
+TEST(Graph, spfaTest) {
+    Graph g(true, true);
+
+    g.addEdge("s", "e", 8);
+    g.addEdge("s", "a", 10);
+    g.addEdge("e", "d", 1);
+    g.addEdge("d", "a", -4);
+    g.addEdge("d", "c", -1);
+    g.addEdge("c", "b", -2);
+    g.addEdge("b", "a", 1);
+    g.addEdge("a", "c", 2);
+    g.addVertex("unreachable");
+
+    const pair<unordered_map<string, float>, unordered_map<string, string>> p = g.spfa("s");
+    ASSERT_EQ(p, g.bellmanFord("s"));
+    ASSERT_EQ(p.first.at("unreachable"), numeric_limits<float>::max());
+
+    mt19937 rng(19);
+    Graph h(true, true);
+    const int n = 500;
+
+    vector<int> potential(n);
+    for (int i = 0; i < n; i++) {
+        h.addVertex(to_string(i));
+        potential[i] = rng() % 50;
+    }
+
+    for (int i = 0; i < 3000; i++) {
+        int u = rng() % n;
+        int v = rng() % n;
+        h.addEdge(to_string(u), to_string(v), (int) (rng() % 50) + potential[u] - potential[v]);
+    }
+
+    ASSERT_EQ(h.spfa("0").first, h.bellmanFord("0").first);
+    ASSERT_EQ(h.negativeCycle().size(), 0);
+
+    // a cycle reachable from the source leaves no shortest paths at all,
+    // while one that is not reachable does not matter
+    g.addEdge("x", "y", -1);
+    g.addEdge("y", "x", -1);
+    const pair<unordered_map<string, float>, unordered_map<string, string>> q = g.spfa("s");
+    ASSERT_EQ(q.second, p.second);
+    ASSERT_EQ(q.first.at("a"), p.first.at("a"));
+    ASSERT_EQ(q.first.at("x"), numeric_limits<float>::max());
+    ASSERT_TRUE(g.spfa("x").first.empty());
+
+    g.setEdgeValue("b", "a", -5);
+    ASSERT_TRUE(g.spfa("s").first.empty());
+    ASSERT_TRUE(g.spfa("s").second.empty());
+}
+
+TEST(Graph, negativeCycleTest) {
+    Graph g(true, true);
+
+    g.addEdge("usd", "eur", -0.1);
+    g.addEdge("eur", "gbp", 0.3);
+    g.addEdge("gbp", "usd", -0.1);
+    g.addEdge("eur", "jpy", -0.5);
+    g.addEdge("jpy", "usd", 0.7);
+    ASSERT_EQ(g.negativeCycle().size(), 0);
+
+    g.setEdgeValue("jpy", "usd", 0.4);
+    g.addEdge("gbp", "chf", 1);
+
+    const vector<string> cycle = g.negativeCycle();
+    const vector<string> actualCycle = {"usd", "eur", "jpy"};
+    ASSERT_EQ(cycle.size(), actualCycle.size());
+
+    float cost = 0;
+    for (size_t i = 0; i < cycle.size(); i++) {
+        cost += g.getEdgeValue(cycle[i], cycle[(i + 1) % cycle.size()]);
+    }
+    ASSERT_LT(cost, 0);
+
+    g.addEdge("c", "c", -1);
+    const vector<string> selfLoop = {"c"};
+    g.removeEdge("jpy", "usd");
+    ASSERT_EQ(g.negativeCycle(), selfLoop);
+}
+
 TEST(Graph, FloydWarshallTest) {
     Graph g(true, true);
 
@@ -132,6 +328,214 @@ TEST(Graph, FloydWarshallTest) {
     }
 }
 
+TEST(Graph, FloydWarshallRandomTest) {
+    Graph g(true, true);
+    mt19937 rng(13);
+    const int n = 150;
+
+    for (int i = 0; i < n; i++) {
+        g.addVertex(to_string(i));
+    }
+
+    for (int i = 0; i < 1500; i++) {
+        g.addEdge(to_string(rng() % n), to_string(rng() % n), rng() % 100);
+    }
+
+    vector<string> vertices;
+    for (string v : g.getVertices()) {
+        vertices.push_back(v);
+    }
+    sort(vertices.begin(), vertices.end());
+
+    const pair<vector<vector<float>>, vector<vector<int>>> p = g.floydWarshall();
+    ASSERT_EQ(g.floydWarshall(4), p);
+
+    for (int i = 0; i < n; i++) {
+        unordered_map<string, float> dist = g.dijkstra(vertices[i]).first;
+
+        for (int j = 0; j < n; j++) {
+            if (dist.find(vertices[j]) == dist.end()) {
+                ASSERT_EQ(p.first[i][j], numeric_limits<float>::max());
+                ASSERT_EQ(p.second[i][j], -1);
+                continue;
+            }
+
+            ASSERT_EQ(p.first[i][j], dist[vertices[j]]);
+
+            float cost = 0;
+            for (int u = i; u != j; u = p.second[u][j]) {
+                cost += g.getEdgeValue(vertices[u], vertices[p.second[u][j]]);
+            }
+            ASSERT_EQ(cost, p.first[i][j]);
+        }
+    }
+}
+
+TEST(Graph, johnsonTest) {
+    Graph g(true, true);
+    mt19937 rng(17);
+    const int n = 200;
+
+    // edge weights offset by a random potential can be negative but never
+    // form a negative cycle
+    vector<int> potential(n);
+    for (int i = 0; i < n; i++) {
+        g.addVertex(to_string(i));
+        potential[i] = rng() % 50;
+    }
+
+    for (int i = 0; i < 1000; i++) {
+        int u = rng() % n;
+        int v = rng() % n;
+        g.addEdge(to_string(u), to_string(v), (int) (rng() % 50) + potential[u] - potential[v]);
+    }
+
+    const pair<vector<vector<float>>, vector<vector<int>>> expected = g.floydWarshall();
+    const pair<vector<vector<float>>, vector<vector<int>>> p = g.johnson();
+    ASSERT_EQ(p.first, expected.first);
+    ASSERT_EQ(g.johnson(4), p);
+
+    vector<string> vertices;
+    for (string v : g.getVertices()) {
+        vertices.push_back(v);
+    }
+    sort(vertices.begin(), vertices.end());
+
+    // walking every path costs n^2 edge lookups; a sample of sources
+    // is enough next to the full comparison above
+    for (int i = 0; i < n; i += 10) {
+        for (int j = 0; j < n; j++) {
+            if (p.second[i][j] == -1) continue;
+
+            float cost = 0;
+            for (int u = i; u != j; u = p.second[u][j]) {
+                cost += g.getEdgeValue(vertices[u], vertices[p.second[u][j]]);
+            }
+            ASSERT_EQ(cost, p.first[i][j]);
+        }
+    }
+
+    unordered_map<string, int> position;
+    for (int i = 0; i < n; i++) {
+        position[vertices[i]] = i;
+    }
+
+    int rows = 0;
+    g.johnson([&](const string & source, const vector<float> & dist, const vector<int> & next) {
+        ASSERT_EQ(dist, p.first[position[source]]);
+        ASSERT_EQ(next, p.second[position[source]]);
+        rows++;
+    }, 4);
+    ASSERT_EQ(rows, n);
+
+    g.addEdge("0", "1", -1000);
+    g.addEdge("1", "0", -1000);
+    ASSERT_FALSE(g.negativeCycle().empty());
+    ASSERT_TRUE(g.johnson().first.empty());
+
+    rows = 0;
+    g.johnson([&](const string &, const vector<float> &, const vector<int> &) {
+        rows++;
+    });
+    ASSERT_EQ(rows, 0);
+}
+
+size_t countReachable(const Graph & g, const string & v) {
+    if (!g.hasVertex(v)) return 0;
+
+    return g.bfs(v).size();
+}
+
+TEST(Graph, concurrentReadTest) {
+    Graph g(true, true);
+    for (int i = 0; i < 100; i++) {
+        g.addEdge(to_string(i), to_string(i + 1), 1);
+    }
+
+    vector<thread> readers;
+    atomic<size_t> failures(0);
+
+    for (int r = 0; r < 4; r++) {
+        readers.push_back(thread([&] {
+            for (int it = 0; it < 50; it++) {
+                this_thread::yield();
+                shared_lock<shared_mutex> lock = g.readLock();
+
+                // the chain only ever grows, so 0 always reaches all of it
+                size_t reachable = countReachable(g, "0");
+                if (reachable != g.getVertices().size()) failures++;
+
+                unordered_map<string, float> dist = g.dijkstra("0").first;
+                if (dist.at("100") != 100) failures++;
+            }
+        }));
+    }
+
+    for (int i = 101; i < 300; i++) {
+        unique_lock<shared_mutex> lock = g.writeLock();
+        g.addEdge(to_string(i - 1), to_string(i), 1);
+        g.addEdge(to_string(i), "0", 1);
+        g.removeEdge(to_string(i), "0");
+    }
+
+    for (thread & reader : readers) {
+        reader.join();
+    }
+
+    ASSERT_EQ(failures.load(), 0);
+    ASSERT_EQ(countReachable(g, "0"), 300);
+
+    Graph copy(g);
+    shared_lock<shared_mutex> lock = g.readLock();
+    unique_lock<shared_mutex> copyLock = copy.writeLock();
+    copy.addEdge("299", "300", 1);
+    ASSERT_EQ(countReachable(copy, "0"), 301);
+}
+
+TEST(Graph, addEdgesTest) {
+    mt19937 rng(37);
+    vector<tuple<string, string, float>> edges;
+    for (int i = 0; i < 5000; i++) {
+        edges.push_back(make_tuple(to_string(rng() % 300), to_string(rng() % 300), (float) (rng() % 100)));
+    }
+
+    for (bool directed : {true, false}) {
+        for (bool weighted : {true, false}) {
+            Graph expected(directed, weighted, true);
+            for (const tuple<string, string, float> & e : edges) {
+                expected.addEdge(get<0>(e), get<1>(e), get<2>(e));
+            }
+
+            Graph g = Graph::fromEdges(directed, weighted, edges, true);
+            ASSERT_EQ(g.getEdges(), expected.getEdges());
+            ASSERT_EQ(g.isReverseIndexed(), expected.isReverseIndexed());
+
+            for (string v : expected.getVertices()) {
+                ASSERT_EQ(g.getId(v), expected.getId(v));
+                if (directed) {
+                    ASSERT_EQ(g.getIncomingNeighbors(v), expected.getIncomingNeighbors(v));
+                }
+
+                if (!weighted) continue;
+
+                expected.forEachNeighbor(v, [&](const string & u, float edgeValue) {
+                    ASSERT_EQ(g.getEdgeValue(v, u), edgeValue);
+                });
+            }
+        }
+    }
+
+    // batches on a non-empty graph overwrite existing edge values
+    Graph g(true, true);
+    g.addEdge("a", "b", 1);
+    g.addEdges({make_tuple("a", "b", 2), make_tuple("a", "c", 3), make_tuple("a", "b", 4), make_tuple("d", "a", 5)});
+
+    ASSERT_EQ(g.getEdgeValue("a", "b"), 4);
+    ASSERT_EQ(g.getEdgeValue("a", "c"), 3);
+    ASSERT_EQ(g.getEdgeValue("d", "a"), 5);
+    ASSERT_EQ(g.getOutDegree("a"), 2);
+}
+
 TEST(Graph, mstTest) {
     Graph g(false, true);
 
@@ -151,32 +555,106 @@ TEST(Graph, mstTest) {
     g.addEdge("f", "e", 8);
     g.addEdge("f", "g", 9);
 
-    const vector<pair<string, string>> tree = g.mst();
-    const vector<pair<string, string>> actualTree = {
-        {"a", "b"},
-        {"a", "d"},
-        {"c", "f"},
-        {"b", "e"},
-        {"c", "e"},
-        {"f", "g"}
-    };
+    for (Graph::MstAlgorithm algorithm : {Graph::PRIM, Graph::KRUSKAL, Graph::BORUVKA}) {
+        const vector<pair<string, string>> tree = g.mst(algorithm, 2);
+        const vector<pair<string, string>> actualTree = {
+            {"a", "b"},
+            {"a", "d"},
+            {"c", "f"},
+            {"c", "e"},
+            {"f", "g"}
+        };
+
+        // a-c and b-e have equal weight, so either one completes the tree
+        ASSERT_EQ(tree.size(), 6);
+
+        float cost = 0;
+        for (const pair<string, string> & edge : tree) {
+            cost += g.getEdgeValue(edge.first, edge.second);
+        }
 
-    const int n = tree.size();
-    for (int i = 0; i < n; i++) {
-        const pair<string, string> edge = actualTree[i];
-        bool found = false;
+        ASSERT_EQ(cost, 24);
 
-        for (int j = 0; j < n; j++) {
-            if (tree[j] != edge) continue;
+        const int n = tree.size();
+        for (const pair<string, string> & edge : actualTree) {
+            bool found = false;
+
+            for (int j = 0; j < n; j++) {
+                if (tree[j] != edge) continue;
 
-            found = true;
-            break;
+                found = true;
+                break;
+            }
+
+            ASSERT_TRUE(found);
         }
+    }
+}
 
-        ASSERT_TRUE(found);
+TEST(Graph, mstForestTest) {
+    Graph g(false, true);
+    mt19937 rng(29);
+    const int n = 600;
+
+    // three components of 200 vertices each, plus an isolated vertex
+    for (int i = 0; i < 3000; i++) {
+        int component = rng() % 3;
+        int u = component * 200 + rng() % 200;
+        int v = component * 200 + rng() % 200;
+        g.addEdge(to_string(u), to_string(v), rng() % 20);
+    }
+    g.addVertex(to_string(n));
+
+    float expectedCost = -1;
+    for (Graph::MstAlgorithm algorithm : {Graph::PRIM, Graph::KRUSKAL, Graph::BORUVKA}) {
+        for (size_t threads : {1, 4}) {
+            const vector<pair<string, string>> forest = g.mst(algorithm, threads);
+            ASSERT_EQ(forest.size(), n - 3);
+
+            DisjointSet components;
+            float cost = 0;
+            for (const pair<string, string> & edge : forest) {
+                components.insert(edge.first);
+                components.insert(edge.second);
+                ASSERT_NE(components.find(edge.first), components.find(edge.second));
+
+                components.setUnion(edge.first, edge.second);
+                cost += g.getEdgeValue(edge.first, edge.second);
+            }
+
+            if (expectedCost < 0) expectedCost = cost;
+            ASSERT_EQ(cost, expectedCost);
+        }
     }
 }
 
+TEST(Graph, queuePolicyTest) {
+    Graph g(false, true);
+    mt19937 rng(41);
+    for (int i = 0; i < 2000; i++) {
+        g.addEdge(to_string(rng() % 400), to_string(rng() % 400), rng() % 30);
+    }
+
+    unordered_map<string, float> dist = g.dijkstra("0").first;
+    ASSERT_EQ(g.dijkstra<Graph::PairingQueue>("0").first, dist);
+    ASSERT_EQ(g.dijkstra<Graph::DaryQueue>("0").first, dist);
+    ASSERT_EQ(g.dijkstra<Graph::RadixQueue>("0").first, dist);
+
+    auto cost = [&g](const vector<pair<string, string>> & tree) {
+        float total = 0;
+        for (const pair<string, string> & edge : tree) {
+            total += g.getEdgeValue(edge.first, edge.second);
+        }
+        return total;
+    };
+
+    const vector<pair<string, string>> tree = g.mst();
+    ASSERT_EQ(g.mst<Graph::PairingQueue>().size(), tree.size());
+    ASSERT_EQ(g.mst<Graph::DaryQueue>().size(), tree.size());
+    ASSERT_EQ(cost(g.mst<Graph::PairingQueue>()), cost(tree));
+    ASSERT_EQ(cost(g.mst<Graph::DaryQueue>()), cost(tree));
+}
+
 TEST(Graph, topologicalSortNoCycleTest) {
     Graph g(true, false);
 
@@ -190,12 +668,15 @@ TEST(Graph, topologicalSortNoCycleTest) {
     g.addEdge("3", "5");
 
     const vector<string> tps = g.topologicalSort();
-    const vector<string> actualTPS = {"1", "2", "3", "4", "5"};
-    const int n = tps.size();
+    const vector<vector<string>> possibleActualTPS = {
+        {"1", "2", "3", "4", "5"},
+        {"1", "2", "3", "5", "4"}
+    };
 
-    for (int i = 0; i < n; i++) {
-        ASSERT_EQ(tps[i], actualTPS[i]);
-    }
+    ASSERT_TRUE(
+        equalVectors(tps, possibleActualTPS[0]) ||
+        equalVectors(tps, possibleActualTPS[1])
+    );
 }
 
 TEST(Graph, topologicalSortCycleTest) {
@@ -209,6 +690,51 @@ TEST(Graph, topologicalSortCycleTest) {
     ASSERT_EQ(tps.size(), 0);
 }
 
+TEST(Graph, topologicalSchedulerTest) {
+    Graph g(true, false);
+
+    g.addEdge("compile", "link");
+    g.addEdge("codegen", "compile");
+    g.addEdge("link", "package");
+    g.addEdge("docs", "package");
+
+    TopologicalScheduler scheduler(g);
+    ASSERT_FALSE(scheduler.done());
+
+    unordered_set<string> ready;
+    while (scheduler.hasReady()) {
+        ready.insert(scheduler.next());
+    }
+
+    ASSERT_TRUE(equalSets(ready, {"codegen", "docs"}));
+    ASSERT_EQ(scheduler.inFlight(), 2);
+    ASSERT_FALSE(scheduler.hasCycle());
+
+    scheduler.complete("docs");
+    ASSERT_FALSE(scheduler.hasReady());
+
+    scheduler.complete("codegen");
+    ASSERT_TRUE(scheduler.hasReady());
+    ASSERT_EQ(scheduler.next(), "compile");
+
+    scheduler.complete("compile");
+    ASSERT_EQ(scheduler.next(), "link");
+
+    scheduler.complete("link");
+    ASSERT_EQ(scheduler.next(), "package");
+    ASSERT_FALSE(scheduler.done());
+
+    scheduler.complete("package");
+    ASSERT_TRUE(scheduler.done());
+    ASSERT_FALSE(scheduler.hasCycle());
+
+    g.addEdge("package", "codegen");
+    TopologicalScheduler cyclic(g);
+    ASSERT_EQ(cyclic.next(), "docs");
+    cyclic.complete("docs");
+    ASSERT_TRUE(cyclic.hasCycle());
+}
+
 TEST(Graph, stronglyConnectedComponentsTest) {
     Graph g(true, false);
 
@@ -219,25 +745,76 @@ TEST(Graph, stronglyConnectedComponentsTest) {
     g.addEdge("0", "3");
     g.addEdge("3", "4");
 
-    const vector<unordered_set<string>> scc = g.stronglyConnectedComponents();
     const vector<unordered_set<string>> actualSCC = {{"0", "1", "2"}, {"3"}, {"4"}};
 
-    ASSERT_EQ(scc.size(), actualSCC.size());
+    // repeated calls must not share any state
+    for (int it = 0; it < 2; it++) {
+        const vector<unordered_set<string>> scc = g.stronglyConnectedComponents();
+        ASSERT_EQ(scc.size(), actualSCC.size());
 
-    const int n = actualSCC.size();
-    for (int i = 0; i < n; i++) {
-        const unordered_set<string> component = scc[i];
-        bool found = false;
+        const int n = actualSCC.size();
+        for (int i = 0; i < n; i++) {
+            const unordered_set<string> component = scc[i];
+            bool found = false;
 
-        for (int j = 0; j < n; j++) {
-            if (!equalSets(component, actualSCC[j])) continue;
+            for (int j = 0; j < n; j++) {
+                if (!equalSets(component, actualSCC[j])) continue;
 
-            found = true;
-            break;
+                found = true;
+                break;
+            }
+
+            ASSERT_TRUE(found);
         }
+    }
+}
+
+TEST(Graph, componentIdsTest) {
+    Graph g(true, false);
+    mt19937 rng(31);
+    const int n = 100;
+
+    for (int i = 0; i < n; i++) {
+        g.addVertex(to_string(i));
+    }
 
-        ASSERT_TRUE(found);
+    for (int i = 0; i < 150; i++) {
+        g.addEdge(to_string(rng() % n), to_string(rng() % n));
     }
+    g.removeVertex("7");
+
+    const pair<vector<uint32_t>, size_t> p = g.componentIds();
+    const vector<uint32_t> & component = p.first;
+    ASSERT_EQ(p.second, g.stronglyConnectedComponents().size());
+
+    // two vertices share a component exactly when each reaches the other
+    const unordered_set<string> vertices = g.getVertices();
+    unordered_map<string, unordered_set<string>> reachable;
+    for (string v : vertices) {
+        for (string u : g.bfs(v)) {
+            reachable[v].insert(u);
+        }
+    }
+
+    for (string u : vertices) {
+        for (string v : vertices) {
+            bool strong = reachable[u].count(v) && reachable[v].count(u);
+            ASSERT_EQ(component[g.getId(u)] == component[g.getId(v)], strong);
+        }
+    }
+
+    Graph dag = g.condensation();
+    ASSERT_EQ(dag.getVertices().size(), p.second);
+    ASSERT_EQ(dag.topologicalSort().size(), p.second);
+
+    g.forEachEdge([&](const string & u, const string & v, float) {
+        uint32_t a = component[g.getId(u)];
+        uint32_t b = component[g.getId(v)];
+        if (a == b) return;
+
+        ASSERT_LT(a, b);
+        ASSERT_TRUE(dag.isAdjacent(to_string(a), to_string(b)));
+    });
 }
 
 TEST(Graph, dfsTest) {
@@ -378,6 +955,132 @@ TEST(Graph, reverseGraphTest) {
     }
 }
 
+TEST(Graph, vertexIdTest) {
+    Graph g(true, true);
+
+    uint32_t a = g.addVertex("a");
+    uint32_t b = g.addVertex("b");
+    ASSERT_EQ(g.addVertex("a"), a);
+    ASSERT_EQ(g.getId("b"), b);
+    ASSERT_EQ(g.getVertex(a), "a");
+
+    g.addEdge(a, b, 5);
+    g.addEdge("b", "c", 2);
+
+    ASSERT_TRUE(g.isAdjacent("a", "b"));
+    ASSERT_EQ(g.getEdgeValue(a, b), 5);
+    ASSERT_TRUE(equalSets(g.getNeighbors("a"), {"b"}));
+
+    unordered_set<uint32_t> neighborIds = g.getNeighborIds(b);
+    ASSERT_EQ(neighborIds.size(), 1);
+    ASSERT_EQ(g.getVertex(*neighborIds.begin()), "c");
+
+    g.removeVertex("b");
+    ASSERT_FALSE(g.hasVertex(b));
+    ASSERT_TRUE(g.isSinkVertex("a"));
+
+    // removed ids are recycled for new vertices
+    ASSERT_EQ(g.addVertex("d"), b);
+    ASSERT_FALSE(g.isAdjacent("a", "d"));
+    ASSERT_TRUE(g.isSourceVertex("c"));
+}
+
+TEST(Graph, neighborViewTest) {
+    Graph g(false, true);
+
+    g.addEdge("a", "b", 1);
+    g.addEdge("a", "c", 2);
+    g.addEdge("b", "c", 3);
+
+    Graph::NeighborView view = g.neighbors("a");
+    ASSERT_EQ(view.size(), 2);
+
+    float total = 0;
+    unordered_set<string> neighbors;
+    for (Graph::Neighbor neighbor : view) {
+        neighbors.insert(g.getVertex(neighbor.id));
+        total += neighbor.edgeValue;
+    }
+
+    ASSERT_TRUE(equalSets(neighbors, {"b", "c"}));
+    ASSERT_EQ(total, 3);
+
+    unordered_map<string, float> visited;
+    g.forEachNeighbor("c", [&visited](const string & v, float edgeValue) {
+        visited[v] = edgeValue;
+    });
+
+    ASSERT_EQ(visited.size(), 2);
+    ASSERT_EQ(visited["a"], 2);
+    ASSERT_EQ(visited["b"], 3);
+
+    size_t vertexCount = 0;
+    g.forEachVertex([&vertexCount](const string &) {
+        vertexCount++;
+    });
+
+    ASSERT_EQ(vertexCount, 3);
+
+    float edgeTotal = 0;
+    size_t edgeCount = 0;
+    g.forEachEdge([&](const string & a, const string & b, float edgeValue) {
+        ASSERT_EQ(g.getEdgeValue(a, b), edgeValue);
+        edgeTotal += edgeValue;
+        edgeCount++;
+    });
+
+    // undirected edges are visited once per direction
+    ASSERT_EQ(edgeCount, 6);
+    ASSERT_EQ(edgeTotal, 12);
+
+    g.addVertex("d");
+    ASSERT_TRUE(g.neighbors("d").empty());
+}
+
+TEST(Graph, reverseIndexTest) {
+    Graph g(true, true, true);
+    ASSERT_TRUE(g.isReverseIndexed());
+
+    g.addEdge("a", "b", 1);
+    g.addEdge("c", "b", 2);
+    g.addEdge("b", "d", 3);
+
+    ASSERT_EQ(g.getInDegree("b"), 2);
+    ASSERT_EQ(g.getOutDegree("b"), 1);
+    ASSERT_TRUE(equalSets(g.getIncomingNeighbors("b"), {"a", "c"}));
+    ASSERT_TRUE(g.isSourceVertex("a"));
+    ASSERT_FALSE(g.isSourceVertex("d"));
+
+    float total = 0;
+    for (Graph::Neighbor neighbor : g.incomingNeighbors("b")) {
+        total += neighbor.edgeValue;
+    }
+
+    ASSERT_EQ(total, 3);
+
+    g.setEdgeValue("c", "b", 5);
+    g.flipEdge("b", "d");
+    ASSERT_TRUE(equalSets(g.getIncomingNeighbors("b"), {"a", "c", "d"}));
+    ASSERT_EQ(g.getInDegree("d"), 0);
+
+    g.removeVertex("c");
+    ASSERT_TRUE(equalSets(g.getIncomingNeighbors("b"), {"a", "d"}));
+
+    Graph revG = g.reverse();
+    ASSERT_TRUE(revG.isReverseIndexed());
+    ASSERT_TRUE(revG.isAdjacent("b", "a"));
+    ASSERT_TRUE(revG.isAdjacent("b", "d"));
+    ASSERT_EQ(revG.getEdgeValue("b", "d"), 3);
+    ASSERT_TRUE(equalSets(revG.getIncomingNeighbors("b"), {}));
+    ASSERT_TRUE(equalSets(revG.getIncomingNeighbors("a"), {"b"}));
+
+    Graph h(false, false);
+    h.addEdge("x", "y");
+    ASSERT_FALSE(h.isReverseIndexed());
+    ASSERT_EQ(h.getInDegree("x"), 1);
+    ASSERT_TRUE(equalSets(h.getIncomingNeighbors("y"), {"x"}));
+}
+
 int main(int argc, char ** argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
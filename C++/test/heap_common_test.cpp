@@ -0,0 +1,197 @@
+#include <bits/stdc++.h>
+#include <gtest/gtest.h>
+#include "dary_heap.h"
+#include "fibheap.h"
+#include "heap_common.h"
+#include "pairing_heap.h"
+#include "radix_heap.h"
+
+using namespace std;
+
+struct PoolNode {
+	int value;
+	PoolNode * next;
+};
+
+TEST(HeapCommon, HashedIndexTest) {
+	heap_index<string, size_t, hash<string>> index;
+	ASSERT_EQ(index.find("a"), 0);
+
+	index.insert("a", 3);
+	index.insert("b", 5);
+	ASSERT_EQ(index.find("a"), 3);
+	ASSERT_EQ(index.find("b"), 5);
+
+	index.erase("a");
+	ASSERT_EQ(index.find("a"), 0);
+
+	index.clear();
+	ASSERT_EQ(index.find("b"), 0);
+}
+
+TEST(HeapCommon, DenseIndexTest) {
+	heap_index<uint32_t, PoolNode *, heap_dense_index> index;
+	PoolNode node = {1, NULL};
+	ASSERT_EQ(index.find(1000), nullptr);
+
+	// inserting past the end grows the array
+	index.insert(1000, &node);
+	ASSERT_EQ(index.find(1000), &node);
+	ASSERT_EQ(index.find(999), nullptr);
+
+	index.reserve(10);
+	ASSERT_EQ(index.find(1000), &node);
+
+	index.erase(1000);
+	ASSERT_EQ(index.find(1000), nullptr);
+}
+
+TEST(HeapCommon, NodePoolTest) {
+	heap_node_pool<PoolNode> pool;
+	pool.reserve(10);
+	ASSERT_EQ(pool.slabs.size(), 1);
+
+	set<PoolNode *> nodes;
+	for (size_t i = 0; i < 3 * HEAP_SLAB_SIZE; i++) {
+		nodes.insert(pool.allocate());
+	}
+	ASSERT_EQ(nodes.size(), 3 * HEAP_SLAB_SIZE);
+	ASSERT_EQ(pool.slabs.size(), 3);
+
+	// released nodes come back before the slabs grow
+	PoolNode * node = *nodes.begin();
+	pool.release(node);
+	ASSERT_EQ(pool.allocate(), node);
+
+	pool.clear();
+	ASSERT_EQ(pool.allocate(), &pool.slabs[0][0]);
+	ASSERT_EQ(pool.slabs.size(), 3);
+}
+
+// Every addressable heap runs the cases below. Keys only ever grow past
+// the last popped key, so the monotone radix heap takes the same ops.
+template <typename Heap>
+class AddressableHeap : public testing::Test {};
+
+typedef testing::Types<
+	BasicFibonacciHeap<uint32_t, uint32_t, less<uint32_t>, heap_dense_index>,
+	BasicPairingHeap<uint32_t, uint32_t, less<uint32_t>, heap_dense_index>,
+	BasicDaryHeap<uint32_t, uint32_t, less<uint32_t>, heap_dense_index>,
+	BasicRadixHeap<uint32_t, uint32_t, heap_dense_index>
+> AddressableHeaps;
+
+TYPED_TEST_SUITE(AddressableHeap, AddressableHeaps);
+
+TYPED_TEST(AddressableHeap, PushPopTest) {
+	TypeParam heap;
+	ASSERT_TRUE(heap.empty());
+
+	heap.push(0, 5);
+	heap.push(1, 0);
+	heap.push(2, 3);
+	ASSERT_EQ(heap.size(), 3);
+	ASSERT_EQ(heap.top(), 1);
+
+	heap.pop();
+	ASSERT_EQ(heap.top(), 2);
+	ASSERT_FALSE(heap.contains(1));
+
+	heap.push(1, 4);
+	heap.pop();
+	ASSERT_EQ(heap.top(), 1);
+	heap.pop();
+	ASSERT_EQ(heap.top(), 0);
+	heap.pop();
+	ASSERT_TRUE(heap.empty());
+}
+
+TYPED_TEST(AddressableHeap, HandleTest) {
+	TypeParam heap;
+	vector<typename TypeParam::handle> handles;
+	for (uint32_t i = 0; i < 100; i++) {
+		handles.push_back(heap.push(i, 1000 + 2 * i));
+	}
+
+	heap.pop();
+	heap.decreaseKey(handles[10], 1001);
+	ASSERT_EQ(heap.top(), 10);
+	ASSERT_EQ(heap.key(handles[10]), 1001);
+
+	heap.erase(handles[10]);
+	heap.erase(50);
+	ASSERT_EQ(heap.size(), 97);
+	ASSERT_FALSE(heap.contains(50));
+	ASSERT_EQ(heap.key(handles[20]), 1040);
+
+	TypeParam copy(heap);
+	heap.pop();
+	ASSERT_EQ(copy.top(), 1);
+	ASSERT_EQ(heap.top(), 2);
+
+	copy = heap;
+	ASSERT_EQ(copy.size(), heap.size());
+	ASSERT_EQ(copy.top(), 2);
+}
+
+// Random pushes, decreaseKeys, erases and pops, checked against a multiset.
+template <typename Heap>
+void randomOps(Heap & heap, uint32_t seed) {
+	multiset<uint32_t> expected;
+	vector<uint32_t> keys;
+	uint32_t last = 0;
+	mt19937 rng(seed);
+
+	for (int step = 0; step < 20000; step++) {
+		int op = rng() % 5;
+		if (op < 2 || heap.empty()) {
+			// spread keys over many bit widths
+			keys.push_back(last + rng() % (1u << (rng() % 24)));
+			expected.insert(keys.back());
+			heap.push(keys.size() - 1, keys.back());
+		} else if (op == 2) {
+			uint32_t elem = rng() % keys.size();
+			if (!heap.contains(elem)) continue;
+			uint32_t key = last + rng() % (keys[elem] - last + 1);
+			expected.erase(expected.find(keys[elem]));
+			expected.insert(key);
+			keys[elem] = key;
+			heap.decreaseKey(elem, key);
+		} else if (op == 3) {
+			uint32_t elem = rng() % keys.size();
+			if (!heap.contains(elem)) continue;
+			expected.erase(expected.find(keys[elem]));
+			heap.erase(elem);
+		} else {
+			last = keys[heap.top()];
+			ASSERT_EQ(last, *expected.begin());
+			expected.erase(expected.begin());
+			heap.pop();
+		}
+		ASSERT_EQ(heap.size(), expected.size());
+	}
+
+	Heap copy(heap);
+	while (!copy.empty()) {
+		ASSERT_EQ(keys[copy.top()], *expected.begin());
+		expected.erase(expected.begin());
+		copy.pop();
+	}
+}
+
+TYPED_TEST(AddressableHeap, RandomTest) {
+	TypeParam heap;
+	heap.reserve(1000);
+	randomOps(heap, 5);
+	ASSERT_FALSE(heap.empty());
+
+	// a cleared heap starts over from key 0
+	heap.clear();
+	ASSERT_TRUE(heap.empty());
+	ASSERT_FALSE(heap.contains(0));
+	randomOps(heap, 7);
+}
+
+int main(int argc, char ** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
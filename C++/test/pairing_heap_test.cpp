@@ -0,0 +1,51 @@
+#include <bits/stdc++.h>
+#include <gtest/gtest.h>
+#include "pairing_heap.h"
+
+using namespace std;
+
+// The shared cases are in heap_common_test.cpp.
+
+TEST(PairingHeap, MaxHeapTest) {
+	BasicPairingHeap<string, int, greater<int>> heap;
+	heap.push("a", 5);
+	heap.push("b", -5);
+	heap.push("c", 0);
+	ASSERT_EQ(heap.top(), "a");
+
+	heap.decreaseKey("b", 10);
+	ASSERT_EQ(heap.top(), "b");
+	heap.pop();
+	ASSERT_EQ(heap.top(), "a");
+}
+
+TEST(PairingHeap, CutTest) {
+	BasicPairingHeap<int, int> heap;
+	vector<BasicPairingHeap<int, int>::handle> handles;
+	for (int i = 0; i < 100; i++) {
+		handles.push_back(heap.push(i, i));
+	}
+
+	// the first pop pairs the root's children up into a deeper tree, so
+	// the nodes cut below sit in the middle of sibling lists
+	heap.pop();
+	for (int i = 20; i <= 90; i += 10) {
+		heap.decreaseKey(handles[i], -i);
+		ASSERT_EQ(heap.top(), i);
+	}
+	heap.erase(handles[90]);
+	heap.erase(handles[55]);
+
+	vector<int> order;
+	while (!heap.empty()) {
+		order.push_back(heap.top());
+		heap.pop();
+	}
+	ASSERT_EQ(order.size(), 97);
+	ASSERT_EQ(vector<int>(order.begin(), order.begin() + 8), vector<int>({80, 70, 60, 50, 40, 30, 20, 1}));
+}
+
+int main(int argc, char ** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
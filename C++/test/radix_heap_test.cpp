@@ -0,0 +1,69 @@
+#include <bits/stdc++.h>
+#include <gtest/gtest.h>
+#include "radix_heap.h"
+
+using namespace std;
+
+// The shared cases are in heap_common_test.cpp.
+
+TEST(RadixHeap, MonotonePushTest) {
+	BasicRadixHeap<string, uint32_t> heap;
+	ASSERT_TRUE(heap.empty());
+
+	heap.push("a", 5);
+	heap.push("b", 0);
+	heap.push("c", 3);
+	ASSERT_EQ(heap.size(), 3);
+	ASSERT_EQ(heap.top(), "b");
+
+	heap.pop();
+	ASSERT_EQ(heap.top(), "c");
+
+	// keys may be pushed again as long as they are not below the last pop
+	heap.push("d", 4);
+	heap.pop();
+	ASSERT_EQ(heap.top(), "d");
+	heap.pop();
+	ASSERT_EQ(heap.top(), "a");
+	heap.pop();
+	ASSERT_TRUE(heap.empty());
+}
+
+TEST(RadixHeap, FloatKeyTest) {
+	BasicRadixHeap<int, float> heap;
+	vector<float> keys = {0.0f, 1e-30f, 0.5f, 1.0f, 1.5f, 3e20f, 2.0f};
+	for (size_t i = 0; i < keys.size(); i++) {
+		heap.push(i, keys[i]);
+	}
+
+	BasicRadixHeap<int, float>::handle h = {5};
+	heap.decreaseKey(h, 1.25f);
+	ASSERT_EQ(heap.key(h), 1.25f);
+
+	vector<int> order;
+	while (!heap.empty()) {
+		order.push_back(heap.top());
+		heap.pop();
+	}
+	ASSERT_EQ(order, vector<int>({0, 1, 2, 3, 5, 4, 6}));
+}
+
+TEST(RadixHeap, WideKeyTest) {
+	BasicRadixHeap<int, uint64_t> heap;
+	heap.push(0, 1ull << 63);
+	heap.push(1, 1ull << 40);
+	heap.push(2, UINT64_MAX);
+	heap.push(3, 3);
+
+	vector<int> order;
+	while (!heap.empty()) {
+		order.push_back(heap.top());
+		heap.pop();
+	}
+	ASSERT_EQ(order, vector<int>({3, 1, 0, 2}));
+}
+
+int main(int argc, char ** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,81 @@
+#include <bits/stdc++.h>
+#include <gtest/gtest.h>
+#include "thread_pool.h"
+
+using namespace std;
+
+TEST(ThreadPool, SizeTest) {
+    ThreadPool pool(4);
+    ASSERT_EQ(pool.size(), 4);
+
+    ThreadPool defaultPool;
+    ASSERT_GE(defaultPool.size(), 1);
+}
+
+TEST(ThreadPool, SubmitTest) {
+    ThreadPool pool(4);
+    atomic<int> counter(0);
+
+    for (int i = 0; i < 100; i++) {
+        pool.submit([&counter] {
+            counter++;
+        });
+    }
+
+    pool.wait();
+    ASSERT_EQ(counter.load(), 100);
+}
+
+TEST(ThreadPool, ParallelForTest) {
+    ThreadPool pool(3);
+    vector<int> values(1000, 0);
+    vector<atomic<int>> workerUses(pool.size());
+
+    pool.parallelFor(values.size(), [&](size_t begin, size_t end, size_t worker) {
+        workerUses[worker]++;
+        for (size_t i = begin; i < end; i++) {
+            values[i] = i * 2;
+        }
+    });
+
+    for (size_t i = 0; i < values.size(); i++) {
+        ASSERT_EQ(values[i], (int) i * 2);
+    }
+
+    for (size_t worker = 0; worker < pool.size(); worker++) {
+        ASSERT_EQ(workerUses[worker].load(), 1);
+    }
+
+    // fewer items than workers, and no items at all
+    int calls = 0;
+    pool.parallelFor(1, [&calls](size_t begin, size_t end, size_t) {
+        calls += end - begin;
+    });
+    pool.parallelFor(0, [&calls](size_t, size_t, size_t) {
+        calls++;
+    });
+
+    ASSERT_EQ(calls, 1);
+}
+
+TEST(ThreadPool, SingleThreadTest) {
+    ThreadPool pool(1);
+    int counter = 0;
+
+    pool.submit([&counter] {
+        counter++;
+    });
+    pool.wait();
+
+    pool.parallelFor(10, [&counter](size_t begin, size_t end, size_t worker) {
+        ASSERT_EQ(worker, 0);
+        counter += end - begin;
+    });
+
+    ASSERT_EQ(counter, 11);
+}
+
+int main(int argc, char ** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}